@@ -1,112 +1,96 @@
 #include <iostream>
 #include <cctype>
+#include <cstdlib>
 #include <cstring>
+#include <new>
+#include <charset.hpp>
+#include <lineread.hpp>
+#include <utf8.hpp>
 
 namespace afanasev
 {
-  char * getline(std::istream & input, size_t & size)
-  {
-    bool isSkipWp = input.flags() & std::ios::skipws;
-    if (isSkipWp)
-    {
-      input >> std::noskipws;
-    }
+  constexpr size_t maxFilters = 8;
 
-    char * str = nullptr;
-    char * tmp = nullptr;
-    size = 0;
-    char n = 0;
-    while (input >> n && n != '\n')
-    {
-      try
-      {
-        tmp = new char[size + 2];
-      }
-      catch (const std::bad_alloc &)
-      {
-        delete[] str;
-        if (isSkipWp)
-        {
-          input >> std::skipws;
-        }
-        throw;
-      }
+  template< size_t Count >
+  void deletingLetters(const char * str, const charset::table_t & isLet, char * const (& outs)[Count])
+  {
+    static_assert(Count <= maxFilters, "one table byte holds at most 8 filters");
 
-      for (size_t i = 0; i < size; ++i)
-      {
-        tmp[i] = str[i];
-      }
-      delete[] str;
-      str = tmp;
-      str[size] = n;
-      size++;
-      str[size] = '\0';
-    }
+    size_t out_l[Count] = {};
+    size_t i = 0;
 
-    if (!input)
+    while (str[i] != '\0')
     {
-      delete[] str;
-      if (isSkipWp)
+      char c = str[i];
+      unsigned char drop = isLet.bits[static_cast< unsigned char >(c)];
+      for (size_t k = 0; k < Count; k++)
       {
-        input >> std::skipws;
+        outs[k][out_l[k]] = c;
+        out_l[k] += !((drop >> k) & 1u);
       }
-      throw std::logic_error("incorrect input");
+      i++;
     }
-
-    if (isSkipWp)
+    for (size_t k = 0; k < Count; k++)
     {
-      input >> std::skipws;
+      outs[k][out_l[k]] = '\0';
     }
-
-    return str;
   }
 
-  void deletingLetters(const char * str, const char * let, char * out)
+  constexpr char vowels[] = "aeiouyAEIOUY";
+  constexpr char let[] = "abcd";
+  constexpr charset::table_t vowelsAndLet = charset::withLiteral(charset::fromLiteral(vowels, 1), let, 2);
+
+  // Bits of а, е, ё, и, о, у, ы, э, ю and я by utf8::cyrillicIndex().
+  constexpr unsigned long long cyrVowels = 1ull | 1ull << 5 | 1ull << 6 | 1ull << 9 | 1ull << 15 |
+      1ull << 20 | 1ull << 28 | 1ull << 30 | 1ull << 31 | 1ull << 32;
+
+  void deleteCyrillicVowels(char * str)
   {
+    size_t len = std::strlen(str);
+    size_t k = 0;
     size_t i = 0;
-    size_t out1_l = 0;
-
-    while (str[i] != '\0')
+    while (i < len)
     {
-      if (!std::strchr(let, str[i]))
+      size_t ascii = utf8::asciiPrefix(str + i, len - i);
+      std::memmove(str + k, str + i, ascii);
+      k += ascii;
+      i += ascii;
+      if (i == len)
       {
-        out[out1_l] = str[i];
-        out1_l++;
+        break;
       }
-      i++;
+      unsigned long codePoint = 0;
+      size_t size = utf8::decode(str + i, len - i, codePoint);
+      if (size == 0)
+      {
+        str[k++] = str[i++];
+        continue;
+      }
+      int index = utf8::cyrillicIndex(codePoint);
+      if (index < 0 || !((cyrVowels >> index) & 1u))
+      {
+        std::memmove(str + k, str + i, size);
+        k += size;
+      }
+      i += size;
     }
-    out[out1_l] = '\0';
-  }
-
-  void deleteVowels(const char * str, char * output)
-  {
-    const char * vowels = "aeiouyAEIOUY";
-    deletingLetters(str, vowels, output);
+    str[k] = '\0';
   }
 }
 
-int main()
+int main(int argc, char * argv[])
 {
+  bool cyrillic = argc > 1 && std::strcmp(argv[1], "--cyrillic") == 0;
   size_t str_lenght = 0;
-  char * str = nullptr;
-  try
-  {
-    str = afanasev::getline(std::cin, str_lenght);
-
-    if (str_lenght == 0)
-    {
-      delete[] str;
-      std::cerr << "Incorrect input" << '\n';
-      return 1;
-    }
-  }
-  catch (const std::bad_alloc &)
+  char * str = lineread::getline(std::cin, str_lenght);
+  if (str == nullptr)
   {
     std::cerr << "Get memory failed" << '\n';
     return 1;
   }
-  catch (const std::logic_error &)
+  if (str_lenght == 0 || std::cin.eof())
   {
+    std::free(str);
     std::cerr << "Incorrect input" << '\n';
     return 1;
   }
@@ -119,34 +103,22 @@ int main()
   }
   catch (const std::bad_alloc &)
   {
-    delete[] str;
+    std::free(str);
     std::cerr << "Get memory failed" << '\n';
     return 1;
   }
 
-  const char * let = "abcd";
-  char * output2 = nullptr;
-  try
-  {
-    output2 = new char[str_lenght + 1];
-    output2[str_lenght] = '\0';
-  }
-  catch (const std::bad_alloc &)
+  char * outs[] = {output1, str};
+  afanasev::deletingLetters(str, afanasev::vowelsAndLet, outs);
+  if (cyrillic)
   {
-    delete[] str;
-    delete[] output1;
-    std::cerr << "Get memory failed" << '\n';
-    return 1;
+    afanasev::deleteCyrillicVowels(output1);
   }
 
-  afanasev::deleteVowels(str, output1);
-  afanasev::deletingLetters(str, let, output2);
-
   std::cout << output1 << '\n';
   delete[] output1;
 
-  std::cout << output2 << '\n';
-  delete[] output2;
-  delete[] str;
+  std::cout << str << '\n';
+  std::free(str);
   return 0;
 }
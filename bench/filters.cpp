@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <charset.hpp>
+
+namespace bench
+{
+  size_t filterRuntime(const char* str, size_t len, const char* mask, char* res)
+  {
+    charset::table_t isFound = {};
+    for (size_t j = 0; mask[j] != '\0'; j++)
+    {
+      isFound.bits[static_cast< unsigned char >(mask[j])] = 1;
+    }
+    size_t k = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+      res[k] = str[i];
+      k += !isFound.bits[static_cast< unsigned char >(str[i])];
+    }
+    return k;
+  }
+
+  size_t filterTable(const char* str, size_t len, const charset::table_t& isFound, char* res)
+  {
+    size_t k = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+      res[k] = str[i];
+      k += !isFound.bits[static_cast< unsigned char >(str[i])];
+    }
+    return k;
+  }
+
+  constexpr char vowels[] = "aeiouyAEIOUY";
+  constexpr charset::table_t isVowel = charset::fromLiteral(vowels);
+
+  template< class Filter >
+  void report(const char* path, const char* shape, const std::string& text, size_t lineLen, Filter filter, bool& first)
+  {
+    std::vector< char > res(lineLen);
+    size_t kept = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos + lineLen <= text.size(); pos += lineLen)
+    {
+      kept += filter(text.data() + pos, lineLen, res.data());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    long long ns = std::chrono::duration_cast< std::chrono::nanoseconds >(elapsed).count();
+    std::cout << (first ? "" : ",\n");
+    std::cout << "  {\"mask\": \"" << path << "\", \"lines\": \"" << shape << "\"";
+    std::cout << ", \"line_bytes\": " << lineLen << ", \"wall_ns\": " << ns;
+    std::cout << ", \"bytes_per_s\": " << static_cast< long long >(ns > 0 ? text.size() * 1e9 / ns : 0.0);
+    std::cout << ", \"kept\": " << kept << "}";
+    first = false;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cerr << "Usage: filters size seed\n";
+    return 1;
+  }
+  size_t size = std::strtoull(argv[1], nullptr, 10);
+  std::minstd_rand rng(std::strtoul(argv[2], nullptr, 10));
+
+  const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789  ,.!?-_";
+  std::string text(size, ' ');
+  for (size_t i = 0; i < size; i++)
+  {
+    text[i] = alphabet[rng() % (sizeof(alphabet) - 1)];
+  }
+
+  const char* shapes[] = {"short", "medium", "long"};
+  const size_t lineLens[] = {16, 256, size};
+  bool first = true;
+  std::cout << "[\n";
+  for (size_t i = 0; i < 3; i++)
+  {
+    bench::report("runtime", shapes[i], text, lineLens[i], [](const char* str, size_t len, char* res)
+    {
+      return bench::filterRuntime(str, len, bench::vowels, res);
+    }, first);
+    bench::report("constexpr", shapes[i], text, lineLens[i], [](const char* str, size_t len, char* res)
+    {
+      return bench::filterTable(str, len, bench::isVowel, res);
+    }, first);
+  }
+  std::cout << "\n]\n";
+}
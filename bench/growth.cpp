@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <growbuf.hpp>
+
+namespace bench
+{
+  struct result_t
+  {
+    long long wallNs;
+    size_t reallocations;
+    size_t bytesCopied;
+    size_t slack;
+  };
+
+  std::vector< size_t > lineLengths(const std::string& kind, size_t lines, std::minstd_rand& rng);
+
+  template< class Policy >
+  result_t readLines(const std::vector< size_t >& lengths, const std::string& text)
+  {
+    result_t result = {0, 0, 0, 0};
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lengths.size(); i++)
+    {
+      growbuf::Buffer< Policy > line;
+      for (size_t j = 0; j < lengths[i]; j++)
+      {
+        if (!line.push(text[j]))
+        {
+          std::cerr << "Out of memory\n";
+          std::exit(1);
+        }
+      }
+      result.reallocations += line.reallocations();
+      result.bytesCopied += line.bytesCopied();
+      result.slack += line.capacity() - line.size();
+      std::free(line.release());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    result.wallNs = std::chrono::duration_cast< std::chrono::nanoseconds >(elapsed).count();
+    return result;
+  }
+
+  template< class Policy >
+  void report(const char* policy, const std::string& kind, const std::vector< size_t >& lengths, const std::string& text, bool& first)
+  {
+    result_t r = readLines< Policy >(lengths, text);
+    std::cout << (first ? "" : ",\n");
+    std::cout << "  {\"policy\": \"" << policy << "\", \"lines\": \"" << kind << "\"";
+    std::cout << ", \"wall_ns\": " << r.wallNs;
+    std::cout << ", \"reallocations\": " << r.reallocations;
+    std::cout << ", \"bytes_copied\": " << r.bytesCopied;
+    std::cout << ", \"slack_bytes\": " << r.slack << "}";
+    first = false;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cerr << "Usage: growth lines seed\n";
+    return 1;
+  }
+  size_t lines = std::strtoull(argv[1], nullptr, 10);
+  unsigned long seed = std::strtoul(argv[2], nullptr, 10);
+
+  const char* kinds[] = {"short", "lognormal", "long", "mixed"};
+  bool first = true;
+  std::cout << "[\n";
+  for (const char* kind: kinds)
+  {
+    std::minstd_rand rng(seed);
+    std::vector< size_t > lengths = bench::lineLengths(kind, lines, rng);
+    size_t longest = 0;
+    for (size_t len: lengths)
+    {
+      longest = len > longest ? len : longest;
+    }
+    std::string text(longest, 'x');
+
+    bench::report< growbuf::Geometric< 2, 1 > >("geometric-2", kind, lengths, text, first);
+    bench::report< growbuf::Geometric< 3, 2 > >("geometric-1.5", kind, lengths, text, first);
+    bench::report< growbuf::FixedStep< 10 > >("fixed+10", kind, lengths, text, first);
+    bench::report< growbuf::FixedStep< 1 > >("fixed+1", kind, lengths, text, first);
+    bench::report< growbuf::SizeClass >("size-class", kind, lengths, text, first);
+  }
+  std::cout << "\n]\n";
+}
+
+std::vector< size_t > bench::lineLengths(const std::string& kind, size_t lines, std::minstd_rand& rng)
+{
+  std::vector< size_t > lengths(lines);
+  std::geometric_distribution< size_t > shortLine(1.0 / 40);
+  std::lognormal_distribution< double > logLine(4.5, 1.0);
+  std::uniform_int_distribution< size_t > longLine(4096, 65536);
+  std::uniform_int_distribution< size_t > percent(0, 99);
+  for (size_t i = 0; i < lines; i++)
+  {
+    if (kind == "short")
+    {
+      lengths[i] = shortLine(rng);
+    }
+    else if (kind == "lognormal")
+    {
+      lengths[i] = static_cast< size_t >(logLine(rng));
+    }
+    else if (kind == "long")
+    {
+      lengths[i] = longLine(rng);
+    }
+    else
+    {
+      lengths[i] = percent(rng) < 95 ? shortLine(rng) : longLine(rng) * 4;
+    }
+  }
+  return lengths;
+}
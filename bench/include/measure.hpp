@@ -0,0 +1,76 @@
+#ifndef MEASURE_HPP
+#define MEASURE_HPP
+
+// Timing of whole lab runs for the bench tools. runOnce() forks, feeds the
+// lab a file on stdin with stdout and stderr sent to /dev/null, and waits
+// for it with wait4() to get the peak RSS along with the wall time.
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace measure
+{
+  struct run_t
+  {
+    long long wallNs;
+    long peakRssKb;
+    int status;
+  };
+
+  // Runs lab with args (argv, nullptr-terminated) and input on stdin.
+  // status is the exit code, 128 + signal if the lab was killed, 127 if it
+  // could not be started and -1 if the run could not be waited for.
+  inline run_t runOnce(const char* lab, char* const* args, const char* input)
+  {
+    run_t result = {0, 0, -1};
+    auto start = std::chrono::steady_clock::now();
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      return result;
+    }
+    if (pid == 0)
+    {
+      int in = open(input, O_RDONLY);
+      int null = open("/dev/null", O_WRONLY);
+      if (in < 0 || null < 0)
+      {
+        _exit(127);
+      }
+      dup2(in, STDIN_FILENO);
+      dup2(null, STDOUT_FILENO);
+      dup2(null, STDERR_FILENO);
+      execv(lab, args);
+      _exit(127);
+    }
+
+    int status = 0;
+    rusage usage = {};
+    if (wait4(pid, std::addressof(status), 0, std::addressof(usage)) < 0)
+    {
+      return result;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    result.wallNs = std::chrono::duration_cast< std::chrono::nanoseconds >(end - start).count();
+    result.peakRssKb = usage.ru_maxrss;
+    result.status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    return result;
+  }
+
+  // Nearest-rank percentile of a sorted, non-empty sample.
+  inline long long percentile(const std::vector< long long >& sorted, size_t pct)
+  {
+    size_t rank = (sorted.size() * pct + 99) / 100;
+    return sorted[rank == 0 ? 0 : rank - 1];
+  }
+}
+
+#endif
@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <measure.hpp>
+
+namespace bench
+{
+  using tokens_t = std::vector< std::string >;
+
+  struct case_t
+  {
+    std::string name;
+    size_t rows;
+    size_t cols;
+    std::vector< int > values;
+  };
+
+  // One lab that implements an operation. extract() pulls the result of
+  // that operation out of the lab's output file in a form shared by the
+  // whole operation and returns an empty string if the output is malformed.
+  // A new kernel is cross-checked by adding its row to impls.
+  struct impl_t
+  {
+    const char* operation;
+    const char* lab;
+    std::string (*extract)(const tokens_t& out);
+  };
+
+  std::string field(const tokens_t& out, size_t i)
+  {
+    return i < out.size() ? out[i] : "";
+  }
+
+  std::string flag(const std::string& value)
+  {
+    if (value == "1" || value == "true")
+    {
+      return "true";
+    }
+    if (value == "0" || value == "false")
+    {
+      return "false";
+    }
+    return "";
+  }
+
+  std::string matrix(const tokens_t& out, size_t i)
+  {
+    if (i + 2 > out.size())
+    {
+      return "";
+    }
+    size_t count = std::strtoull(out[i].c_str(), nullptr, 10) * std::strtoull(out[i + 1].c_str(), nullptr, 10);
+    if (count > out.size() - i - 2)
+    {
+      return "";
+    }
+    std::string result = out[i] + ' ' + out[i + 1];
+    for (size_t j = 0; j < count; j++)
+    {
+      result += ' ' + out[i + 2 + j];
+    }
+    return result;
+  }
+
+  const impl_t impls[] = {
+    {"saddle_points", "sogdanov.sanal/P3", [](const tokens_t& out)
+      {
+        return field(out, 1);
+      }},
+    {"saddle_points", "bukreev.yakov/P3", [](const tokens_t& out)
+      {
+        return field(out, 0);
+      }},
+    {"saddle_points", "khalikov.mirat/P3", [](const tokens_t& out)
+      {
+        return field(out, 3);
+      }},
+    {"lft_bot_clk", "lachugin.mikhail/P3", [](const tokens_t& out)
+      {
+        return matrix(out, 0);
+      }},
+    {"lft_bot_clk", "dirko.nikita/P3", [](const tokens_t& out)
+      {
+        return matrix(out, 0);
+      }},
+    {"lft_bot_clk", "saldaev.lev/P3", [](const tokens_t& out)
+      {
+        return matrix(out, 1);
+      }},
+    {"lft_bot_clk", "shirokov.arsenii/P3", [](const tokens_t& out)
+      {
+        return matrix(out, 3);
+      }},
+    {"lwr_tri_mtx", "chernikov.leonid/P3", [](const tokens_t& out)
+      {
+        return flag(field(out, field(out, 0) == "LWR_TRI_MTX" ? 2 : 0));
+      }},
+    {"lwr_tri_mtx", "dirko.nikita/P3", [](const tokens_t& out)
+      {
+        return out.empty() ? "" : flag(out.back());
+      }},
+    {"lwr_tri_mtx", "samarin.denis/p3", [](const tokens_t& out)
+      {
+        return std::string(out.size() < 3 ? "" : std::find(out.begin(), out.end(), "не") != out.end() ? "false" : "true");
+      }},
+    {"lwr_tri_mtx", "shirokov.arsenii/P3", [](const tokens_t& out)
+      {
+        return out.empty() ? "" : flag(out.back());
+      }}
+  };
+  const size_t implCount = sizeof(impls) / sizeof(impls[0]);
+
+  case_t filled(const std::string& name, size_t rows, size_t cols, int value);
+  case_t random(const std::string& name, size_t rows, size_t cols, int low, int high, std::minstd_rand& rng);
+  std::vector< case_t > generateCases(size_t count, std::minstd_rand& rng);
+  void writeCase(const std::string& path, const case_t& matrix);
+  void reportDivergence(const case_t& matrix, const std::vector< size_t >& members, const std::vector< std::string >& results, bool& first);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::cerr << "Usage: p3diff labdir cases seed workdir\n";
+    return 1;
+  }
+
+  std::string labdir = argv[1];
+  size_t count = std::strtoull(argv[2], nullptr, 10);
+  unsigned long seed = std::strtoul(argv[3], nullptr, 10);
+  std::string workdir = argv[4];
+
+  std::minstd_rand rng(seed);
+  std::vector< bench::case_t > cases = bench::generateCases(count, rng);
+  std::string input = workdir + "/p3diff-input";
+  std::string output = workdir + "/p3diff-output";
+  std::string mode = "2";
+
+  std::vector< std::string > labs(bench::implCount);
+  for (size_t i = 0; i < bench::implCount; i++)
+  {
+    labs[i] = labdir + '/' + bench::impls[i].lab + "/lab";
+  }
+  std::vector< std::vector< long long > > times(bench::implCount);
+  std::vector< size_t > failures(bench::implCount, 0);
+  size_t divergences = 0;
+  bool first = true;
+
+  std::cout << "{\n";
+  std::cout << "  \"seed\": " << seed << ",\n";
+  std::cout << "  \"cases\": " << cases.size() << ",\n";
+  std::cout << "  \"divergences\": [\n";
+  for (size_t c = 0; c < cases.size(); c++)
+  {
+    bench::writeCase(input, cases[c]);
+    std::vector< std::string > results(bench::implCount);
+    std::vector< size_t > ran;
+    for (size_t i = 0; i < bench::implCount; i++)
+    {
+      size_t known = 0;
+      while (known < ran.size() && labs[ran[known]] != labs[i])
+      {
+        known++;
+      }
+      if (known != ran.size())
+      {
+        results[i] = results[ran[known]];
+        times[i].push_back(times[ran[known]].back());
+      }
+      else
+      {
+        std::remove(output.c_str());
+        char* args[] = {const_cast< char* >(labs[i].c_str()), const_cast< char* >(mode.c_str()),
+          const_cast< char* >(input.c_str()), const_cast< char* >(output.c_str()), nullptr};
+        measure::run_t run = measure::runOnce(labs[i].c_str(), args, "/dev/null");
+        if (run.status < 0)
+        {
+          std::cerr << "Failed to run " << labs[i] << '\n';
+          return 2;
+        }
+        if (run.status == 127)
+        {
+          std::cerr << labs[i] << " could not be started\n";
+          return 2;
+        }
+        std::ifstream check(output);
+        std::ostringstream text;
+        text << check.rdbuf();
+        results[i] = run.status == 0 ? text.str() : "exit " + std::to_string(run.status);
+        ran.push_back(i);
+        times[i].push_back(run.wallNs);
+      }
+    }
+    for (size_t i = 0; i < bench::implCount; i++)
+    {
+      if (results[i].compare(0, 5, "exit ") == 0)
+      {
+        failures[i]++;
+        continue;
+      }
+      std::istringstream text(results[i]);
+      bench::tokens_t out{std::istream_iterator< std::string >(text), std::istream_iterator< std::string >()};
+      results[i] = bench::impls[i].extract(out);
+      if (results[i].empty())
+      {
+        results[i] = "malformed output";
+      }
+    }
+    for (size_t i = 0; i < bench::implCount; i++)
+    {
+      if (i != 0 && std::strcmp(bench::impls[i].operation, bench::impls[i - 1].operation) == 0)
+      {
+        continue;
+      }
+      std::vector< size_t > members;
+      bool same = true;
+      for (size_t j = i; j < bench::implCount && std::strcmp(bench::impls[j].operation, bench::impls[i].operation) == 0; j++)
+      {
+        members.push_back(j);
+        same = same && results[j] == results[i];
+      }
+      if (!same)
+      {
+        divergences++;
+        bench::reportDivergence(cases[c], members, results, first);
+      }
+    }
+  }
+  std::cout << (first ? "" : "\n") << "  ],\n";
+
+  std::cout << "  \"implementations\": [\n";
+  for (size_t i = 0; i < bench::implCount; i++)
+  {
+    std::vector< long long >& sample = times[i];
+    std::sort(sample.begin(), sample.end());
+    std::cout << "    {\"operation\": \"" << bench::impls[i].operation << "\", \"lab\": \"" << bench::impls[i].lab << "\"";
+    std::cout << ", \"failures\": " << failures[i];
+    if (!sample.empty())
+    {
+      long long total = 0;
+      for (size_t j = 0; j < sample.size(); j++)
+      {
+        total += sample[j];
+      }
+      std::cout << ", \"wall_ns\": {\"total\": " << total << ", \"min\": " << sample.front();
+      std::cout << ", \"median\": " << measure::percentile(sample, 50);
+      std::cout << ", \"p95\": " << measure::percentile(sample, 95) << "}";
+    }
+    std::cout << "}" << (i + 1 == bench::implCount ? "\n" : ",\n");
+  }
+  std::cout << "  ]\n";
+  std::cout << "}\n";
+  return divergences == 0 ? 0 : 1;
+}
+
+bench::case_t bench::filled(const std::string& name, size_t rows, size_t cols, int value)
+{
+  return case_t{name, rows, cols, std::vector< int >(rows * cols, value)};
+}
+
+bench::case_t bench::random(const std::string& name, size_t rows, size_t cols, int low, int high, std::minstd_rand& rng)
+{
+  case_t matrix = filled(name, rows, cols, 0);
+  std::uniform_int_distribution< int > value(low, high);
+  for (size_t i = 0; i < matrix.values.size(); i++)
+  {
+    matrix.values[i] = value(rng);
+  }
+  return matrix;
+}
+
+std::vector< bench::case_t > bench::generateCases(size_t count, std::minstd_rand& rng)
+{
+  std::vector< case_t > cases;
+  cases.push_back(filled("0x0", 0, 0, 0));
+  cases.push_back(random("1x1", 1, 1, -1000, 1000, rng));
+  cases.push_back(random("1xN", 1, 9, -1000, 1000, rng));
+  cases.push_back(random("Nx1", 9, 1, -1000, 1000, rng));
+  cases.push_back(random("2x5", 2, 5, -1000, 1000, rng));
+  cases.push_back(random("5x2", 5, 2, -1000, 1000, rng));
+  cases.push_back(filled("all-equal", 5, 5, 7));
+  cases.push_back(filled("all-zero", 4, 4, 0));
+  cases.push_back(filled("all-int-max", 3, 3, INT_MAX));
+  cases.push_back(filled("all-int-min", 3, 3, INT_MIN));
+
+  case_t limits = random("int-limits", 4, 5, 0, 2, rng);
+  const int limit[] = {INT_MIN, 0, INT_MAX};
+  for (size_t i = 0; i < limits.values.size(); i++)
+  {
+    limits.values[i] = limit[limits.values[i]];
+  }
+  cases.push_back(limits);
+
+  case_t lower = random("lower-triangular", 6, 6, -1000, 1000, rng);
+  for (size_t i = 0; i < lower.rows; i++)
+  {
+    for (size_t j = i + 1; j < lower.cols; j++)
+    {
+      lower.values[i * lower.cols + j] = 0;
+    }
+  }
+  cases.push_back(lower);
+  cases.push_back(random("100x100", 100, 100, -1000, 1000, rng));
+
+  std::uniform_int_distribution< size_t > side(1, 40);
+  for (size_t i = 0; i < count; i++)
+  {
+    size_t rows = side(rng);
+    size_t cols = side(rng);
+    bool ties = i % 2 != 0;
+    std::string name = "random-" + std::to_string(i) + ' ' + std::to_string(rows) + 'x' + std::to_string(cols);
+    cases.push_back(random(name, rows, cols, ties ? -2 : -1000, ties ? 2 : 1000, rng));
+  }
+  return cases;
+}
+
+void bench::writeCase(const std::string& path, const case_t& matrix)
+{
+  std::ofstream out(path);
+  out << matrix.rows << ' ' << matrix.cols << '\n';
+  for (size_t i = 0; i < matrix.rows; i++)
+  {
+    for (size_t j = 0; j < matrix.cols; j++)
+    {
+      out << matrix.values[i * matrix.cols + j] << (j + 1 == matrix.cols ? '\n' : ' ');
+    }
+  }
+}
+
+void bench::reportDivergence(const case_t& matrix, const std::vector< size_t >& members, const std::vector< std::string >& results, bool& first)
+{
+  const size_t excerpt = 80;
+  const std::string& base = results[members.front()];
+  size_t from = base.size();
+  for (size_t i = 1; i < members.size(); i++)
+  {
+    const std::string& result = results[members[i]];
+    size_t same = 0;
+    while (same < base.size() && same < result.size() && base[same] == result[same])
+    {
+      same++;
+    }
+    from = std::min(from, same);
+  }
+  size_t space = base.rfind(' ', from);
+  from = (from == 0 || space == std::string::npos) ? 0 : space + 1;
+
+  std::cout << (first ? "" : ",\n");
+  std::cout << "    {\"operation\": \"" << impls[members.front()].operation << "\", \"case\": \"" << matrix.name << "\"";
+  std::cout << ", \"from\": " << from << ", \"results\": {";
+  for (size_t i = 0; i < members.size(); i++)
+  {
+    const std::string& result = results[members[i]];
+    std::string shown = from < result.size() ? result.substr(from, excerpt) : "";
+    std::cout << (i == 0 ? "" : ", ") << '"' << impls[members[i]].lab << "\": \"" << (from != 0 ? "..." : "") << shown;
+    std::cout << (from + excerpt < result.size() ? "..." : "") << '"';
+  }
+  std::cout << "}}";
+  first = false;
+}
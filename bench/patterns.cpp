@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <acmatch.hpp>
+
+namespace bench
+{
+  size_t removeNaive(const char* str, size_t len, const char* const* patterns, size_t count, char* res)
+  {
+    std::vector< bool > drop(len, false);
+    for (size_t p = 0; p < count; p++)
+    {
+      size_t plen = std::strlen(patterns[p]);
+      for (const char* hit = std::strstr(str, patterns[p]); hit; hit = std::strstr(hit + 1, patterns[p]))
+      {
+        for (size_t i = 0; i < plen; i++)
+        {
+          drop[hit - str + i] = true;
+        }
+      }
+    }
+    size_t k = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+      res[k] = str[i];
+      k += !drop[i];
+    }
+    return k;
+  }
+
+  long long elapsedNs(std::chrono::steady_clock::time_point start)
+  {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(elapsed).count();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cerr << "Usage: patterns size seed\n";
+    return 1;
+  }
+  size_t size = std::strtoull(argv[1], nullptr, 10);
+  std::minstd_rand rng(std::strtoul(argv[2], nullptr, 10));
+
+  const size_t vocabulary = 512;
+  std::vector< std::string > words(vocabulary);
+  for (size_t i = 0; i < vocabulary; i++)
+  {
+    size_t len = rng() % 8 + 2;
+    for (size_t j = 0; j < len; j++)
+    {
+      words[i] += static_cast< char >('a' + rng() % 26);
+    }
+  }
+  std::string text;
+  text.reserve(size + 16);
+  while (text.size() < size)
+  {
+    text += words[rng() % vocabulary];
+    text += ' ';
+  }
+
+  const size_t counts[] = {1, 4, 16, 64};
+  std::vector< char > acRes(text.size());
+  std::vector< char > naiveRes(text.size());
+  std::cout << "[\n";
+  for (size_t i = 0; i < 4; i++)
+  {
+    std::vector< std::string > stopWords(counts[i]);
+    std::vector< const char* > patterns(counts[i]);
+    for (size_t p = 0; p < counts[i]; p++)
+    {
+      stopWords[p] = ' ' + words[p] + ' ';
+      patterns[p] = stopWords[p].c_str();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    acmatch::Automaton automaton(patterns.data(), patterns.size());
+    long long buildNs = bench::elapsedNs(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t acLen = automaton.remove(text.c_str(), text.size(), acRes.data());
+    long long acNs = bench::elapsedNs(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t matches = automaton.count(text.c_str(), text.size());
+    long long countNs = bench::elapsedNs(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t naiveLen = bench::removeNaive(text.c_str(), text.size(), patterns.data(), patterns.size(), naiveRes.data());
+    long long naiveNs = bench::elapsedNs(start);
+
+    bool same = acLen == naiveLen && std::memcmp(acRes.data(), naiveRes.data(), acLen) == 0;
+    std::cout << (i == 0 ? "" : ",\n");
+    std::cout << "  {\"patterns\": " << counts[i] << ", \"states\": " << automaton.states();
+    std::cout << ", \"matches\": " << matches << ", \"build_ns\": " << buildNs;
+    std::cout << ", \"ac_remove_ns\": " << acNs << ", \"ac_count_ns\": " << countNs;
+    std::cout << ", \"strstr_remove_ns\": " << naiveNs;
+    std::cout << ", \"same_output\": " << (same ? "true" : "false") << "}";
+  }
+  std::cout << "\n]\n";
+}
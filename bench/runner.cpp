@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <measure.hpp>
+
+namespace bench
+{
+  size_t generateP3(const std::string& path, size_t size, std::minstd_rand& rng);
+  size_t generateP4(const std::string& path, size_t size, std::minstd_rand& rng);
+  size_t generateP4Lines(const std::string& path, size_t size, std::minstd_rand& rng, size_t& lines);
+  size_t generateP5(const std::string& path, std::minstd_rand& rng);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 8 && argc != 9)
+  {
+    std::cerr << "Usage: runner kind lab size runs warmup seed workdir [threads]\n";
+    return 1;
+  }
+
+  std::string kind = argv[1];
+  for (size_t i = 0; i < kind.size(); i++)
+  {
+    kind[i] = std::toupper(static_cast< unsigned char >(kind[i]));
+  }
+  const char* lab = argv[2];
+  size_t size = std::strtoull(argv[3], nullptr, 10);
+  size_t runs = std::strtoull(argv[4], nullptr, 10);
+  size_t warmup = std::strtoull(argv[5], nullptr, 10);
+  unsigned long seed = std::strtoul(argv[6], nullptr, 10);
+  std::string workdir = argv[7];
+  std::string threads = argc == 9 ? argv[8] : "";
+
+  if (runs == 0)
+  {
+    std::cerr << "At least one measured run is required\n";
+    return 1;
+  }
+
+  std::minstd_rand rng(seed);
+  std::string input = workdir + "/bench-input";
+  std::string output = workdir + "/bench-output";
+  std::string mode = "2";
+
+  size_t inputBytes = 0;
+  size_t lines = 1;
+  std::string batch = "--batch";
+  std::vector< char* > args;
+  args.push_back(const_cast< char* >(lab));
+  if (kind == "P3")
+  {
+    inputBytes = bench::generateP3(input, size, rng);
+    args.push_back(const_cast< char* >(mode.c_str()));
+    args.push_back(const_cast< char* >(input.c_str()));
+    args.push_back(const_cast< char* >(output.c_str()));
+  }
+  else if (kind == "P4" && !threads.empty())
+  {
+    inputBytes = bench::generateP4Lines(input, size, rng, lines);
+    args.push_back(const_cast< char* >(batch.c_str()));
+    args.push_back(const_cast< char* >(threads.c_str()));
+  }
+  else if (kind == "P4")
+  {
+    inputBytes = bench::generateP4(input, size, rng);
+  }
+  else if (kind == "P5")
+  {
+    inputBytes = bench::generateP5(input, rng);
+  }
+  else
+  {
+    std::cerr << "No input generator for " << argv[1] << '\n';
+    return 1;
+  }
+  args.push_back(nullptr);
+  const char* stdinPath = (kind == "P3" ? "/dev/null" : input.c_str());
+
+  std::vector< long long > times;
+  long peakRss = 0;
+  for (size_t i = 0; i < warmup + runs; i++)
+  {
+    measure::run_t run = measure::runOnce(lab, args.data(), stdinPath);
+    if (run.status < 0)
+    {
+      std::cerr << "Failed to run " << lab << '\n';
+      return 2;
+    }
+    if (run.status != 0)
+    {
+      std::cerr << lab << " exited with status " << run.status << (run.status == 127 ? " (or could not be started)" : "") << '\n';
+      return 2;
+    }
+    if (i >= warmup)
+    {
+      times.push_back(run.wallNs);
+      peakRss = std::max(peakRss, run.peakRssKb);
+    }
+  }
+  std::sort(times.begin(), times.end());
+
+  long long median = measure::percentile(times, 50);
+  double throughput = median > 0 ? inputBytes * 1e9 / median : 0.0;
+  double lineRate = median > 0 ? lines * 1e9 / median : 0.0;
+
+  std::cout << "{\n";
+  std::cout << "  \"lab\": \"" << lab << "\",\n";
+  std::cout << "  \"kind\": \"" << kind << "\",\n";
+  std::cout << "  \"size\": " << size << ",\n";
+  std::cout << "  \"seed\": " << seed << ",\n";
+  std::cout << "  \"runs\": " << runs << ",\n";
+  std::cout << "  \"warmup\": " << warmup << ",\n";
+  std::cout << "  \"input_bytes\": " << inputBytes << ",\n";
+  std::cout << "  \"lines\": " << lines << ",\n";
+  if (!threads.empty())
+  {
+    std::cout << "  \"threads\": " << threads << ",\n";
+  }
+  std::cout << "  \"wall_ns\": {\"min\": " << times.front();
+  std::cout << ", \"median\": " << median;
+  std::cout << ", \"p95\": " << measure::percentile(times, 95) << "},\n";
+  std::cout << "  \"peak_rss_kb\": " << peakRss << ",\n";
+  if (kind != "P5")
+  {
+    std::cout << "  \"throughput_bytes_per_s\": " << static_cast< long long >(throughput) << ",\n";
+  }
+  std::cout << "  \"lines_per_s\": " << static_cast< long long >(lineRate) << "\n";
+  std::cout << "}\n";
+}
+
+size_t bench::generateP3(const std::string& path, size_t size, std::minstd_rand& rng)
+{
+  size_t side = static_cast< size_t >(std::sqrt(static_cast< double >(size)));
+  side = std::max(side, static_cast< size_t >(1));
+
+  std::ofstream out(path);
+  out << side << ' ' << side << '\n';
+  for (size_t i = 0; i < side; i++)
+  {
+    for (size_t j = 0; j < side; j++)
+    {
+      long value = static_cast< long >(rng() % 2001) - 1000;
+      out << value << (j + 1 == side ? '\n' : ' ');
+    }
+  }
+  return static_cast< size_t >(out.tellp());
+}
+
+size_t bench::generateP4(const std::string& path, size_t size, std::minstd_rand& rng)
+{
+  const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789  ,.!?-_";
+  const size_t alphabetSize = sizeof(alphabet) - 1;
+
+  std::string line(size, ' ');
+  for (size_t i = 0; i < size; i++)
+  {
+    line[i] = alphabet[rng() % alphabetSize];
+  }
+  line += '\n';
+
+  std::ofstream out(path, std::ios::binary);
+  out.write(line.data(), line.size());
+  return line.size();
+}
+
+size_t bench::generateP4Lines(const std::string& path, size_t size, std::minstd_rand& rng, size_t& lines)
+{
+  const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789  ,.!?-_";
+  const size_t alphabetSize = sizeof(alphabet) - 1;
+  const size_t maxLine = 160;
+
+  std::string text;
+  text.reserve(size + maxLine + 1);
+  lines = 0;
+  while (text.size() < size)
+  {
+    size_t len = rng() % maxLine + 1;
+    for (size_t i = 0; i < len; i++)
+    {
+      text += alphabet[rng() % alphabetSize];
+    }
+    text += '\n';
+    lines++;
+  }
+
+  std::ofstream out(path, std::ios::binary);
+  out.write(text.data(), text.size());
+  return text.size();
+}
+
+size_t bench::generateP5(const std::string& path, std::minstd_rand& rng)
+{
+  long x = static_cast< long >(rng() % 201) - 100;
+  long y = static_cast< long >(rng() % 201) - 100;
+  long k = static_cast< long >(rng() % 9) + 1;
+
+  std::ofstream out(path);
+  out << x << ' ' << y << ' ' << k << '\n';
+  return static_cast< size_t >(out.tellp());
+}
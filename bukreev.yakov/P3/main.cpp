@@ -1,6 +1,8 @@
 #include <iostream>
 #include <cstring>
 #include <fstream>
+#include <mtxbuf.hpp>
+#include <probe.hpp>
 
 namespace bukreev
 {
@@ -52,6 +54,13 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  mtxbuf::Policy policy = mtxbuf::Policy::plain;
+  if (!mtxbuf::policyFromEnv(policy))
+  {
+    std::cerr << "Unknown LAB_MTX_ALLOC policy.\n";
+    return 1;
+  }
+
   std::ifstream input(argv[2]);
 
   size_t rows = 0, cols = 0;
@@ -66,6 +75,7 @@ int main(int argc, char* argv[])
   const size_t MTX_MAX_SIZE = 10000;
   int stackMatrix[MTX_MAX_SIZE] = {};
   int* matrix = nullptr;
+  mtxbuf::Buffer heapMatrix(policy);
 
   if (mode == 1)
   {
@@ -73,16 +83,17 @@ int main(int argc, char* argv[])
   }
   else
   {
-    matrix = new int[rows * cols];
+    matrix = heapMatrix.allocate(rows * cols);
+    if (!matrix)
+    {
+      std::cerr << "Failed to allocate the matrix.\n";
+      return 3;
+    }
   }
 
   bukreev::inputMatrix(input, matrix, rows, cols);
   if (input.fail())
   {
-    if (mode == 2)
-    {
-      delete[] matrix;
-    }
     std::cerr << "Content of the input file is invalid.\n";
     return 2;
   }
@@ -96,10 +107,6 @@ int main(int argc, char* argv[])
   }
   catch (const std::bad_alloc& e)
   {
-    if (mode == 2)
-    {
-      delete[] matrix;
-    }
     return 3;
   }
 
@@ -116,16 +123,13 @@ int main(int argc, char* argv[])
   bukreev::outputMatrix(output, matrix, rows, cols);
   output << '\n';
 
-  if (mode == 2)
-  {
-    delete[] matrix;
-  }
-
   return 0;
 }
 
 std::istream& bukreev::inputMatrix(std::istream& in, int* matrix, size_t rows, size_t cols)
 {
+  PROBE_SCOPE("inputMatrix");
+  PROBE_COUNT("elements parsed", rows * cols);
   for (size_t i = 0; i < rows * cols; i++)
   {
     in >> matrix[i];
@@ -135,28 +139,47 @@ std::istream& bukreev::inputMatrix(std::istream& in, int* matrix, size_t rows, s
 
 size_t bukreev::cntSdlPnt(const int* matrix, size_t rows, size_t cols)
 {
+  PROBE_SCOPE("cntSdlPnt");
+  if (rows == 0 || cols == 0)
+  {
+    return 0;
+  }
+
   size_t res = 0;
 
   size_t* colsMaximums = new size_t[cols];
+  int* colsMaxValues = nullptr;
+  try
+  {
+    colsMaxValues = new int[cols];
+  }
+  catch (const std::bad_alloc&)
+  {
+    delete[] colsMaximums;
+    throw;
+  }
 
-  for (size_t i = 0; i < cols; i++)
+  for (size_t j = 0; j < cols; j++)
   {
-    int maxElem = matrix[i];
-    size_t maxIndex = 0;
+    colsMaxValues[j] = matrix[j];
+    colsMaximums[j] = 0;
+  }
 
-    for (size_t j = 1; j < rows; j++)
+  for (size_t i = 1; i < rows; i++)
+  {
+    const int* row = matrix + i * cols;
+    for (size_t j = 0; j < cols; j++)
     {
-      int elem = matrix[j * cols + i];
-      if (elem > maxElem)
+      if (row[j] > colsMaxValues[j])
       {
-        maxElem = elem;
-        maxIndex = j;
+        colsMaxValues[j] = row[j];
+        colsMaximums[j] = i;
       }
     }
-
-    colsMaximums[i] = maxIndex;
   }
 
+  delete[] colsMaxValues;
+
   for (size_t i = 0; i < rows; i++)
   {
     int minElem = matrix[i * cols];
@@ -185,6 +208,7 @@ size_t bukreev::cntSdlPnt(const int* matrix, size_t rows, size_t cols)
 
 void bukreev::lftTopClk(int* matrix, size_t rows, size_t cols)
 {
+  PROBE_SCOPE("lftTopClk");
   size_t start = 0;
   size_t n = rows, m = cols;
 
@@ -245,6 +269,7 @@ void bukreev::lftTopClk(int* matrix, size_t rows, size_t cols)
 
 void bukreev::outputMatrix(std::ostream& out, const int* matrix, size_t rows, size_t cols)
 {
+  PROBE_SCOPE("outputMatrix");
   out << rows << ' ' << cols;
   for (size_t i = 0; i < rows * cols; i++)
   {
@@ -1,24 +1,82 @@
 #include <iostream>
 #include <cstdlib>
+#include <cerrno>
 #include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <acmatch.hpp>
+#include <ascii.hpp>
+#include <charset.hpp>
+#include <linemap.hpp>
+#include <lineread.hpp>
+#include <probe.hpp>
+#include <utf8.hpp>
 
 namespace bukreev
 {
-  constexpr size_t initialSize = 4;
+  constexpr size_t chunkSize = 4096;
 
-  char* inputString(std::istream& in, size_t& len);
+  char* excsndLatrmvStream(std::istream& in, std::ostream& out, const unsigned char* keep, size_t& len);
 
-  char* growString(const char* oldStr, size_t& capacity);
+  size_t latrmvAscii(const char* str, size_t len, char* resStr);
+  char* latrmvUtf8(const char* str, size_t len, char* resStr, bool cyrillic);
+  void excsndLatrmv(const char* str, size_t len, const unsigned char* keep, char* excRes, size_t& excLen, char* latRes, size_t& latLen);
 
-  char* excsnd(const char* first, const char* second, char* resStr);
-  char* latrmv(const char* str, char* resStr);
+  char* readAll(std::istream& in, size_t& len);
+  size_t excsndLatrmvLines(const char* begin, const char* end, const unsigned char* keep, char* out, size_t& empty);
+  bool parseWorkers(const char* arg, size_t& workers);
+  int runBatch(std::istream& in, std::ostream& out, const unsigned char* keep, size_t workers);
+  int runFile(const char* path, std::ostream& out, const unsigned char* keep, size_t workers);
+  int runLines(const char* input, size_t len, std::ostream& out, const unsigned char* keep, size_t workers);
+  int runStrip(std::istream& in, std::ostream& out, const char* const* patterns, size_t count);
 }
 
-int main()
+namespace
 {
+  constexpr char stringToExclude[] = "abc";
+  // Bit 1 keeps bytes outside stringToExclude, bit 2 keeps non-Latin bytes.
+  constexpr charset::table_t excsndLatrmvKeep = charset::invert(charset::withLatin(charset::fromLiteral(stringToExclude, 1), 2), 3);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc > 1 && std::strcmp(argv[1], "--strip") == 0)
+  {
+    if (argc < 3)
+    {
+      std::cerr << "The --strip option needs at least one pattern.\n";
+      return 1;
+    }
+    return bukreev::runStrip(std::cin, std::cout, argv + 2, argc - 2);
+  }
+
+  bool batch = argc > 1 && std::strcmp(argv[1], "--batch") == 0;
+  bool file = argc > 1 && std::strcmp(argv[1], "--file") == 0;
+  if (batch || file)
+  {
+    if (file && argc < 3)
+    {
+      std::cerr << "The --file option needs a path.\n";
+      return 1;
+    }
+    size_t workers = 0;
+    if (!bukreev::parseWorkers(argc > 2 + file ? argv[2 + file] : nullptr, workers))
+    {
+      std::cerr << "The worker count must be a positive number.\n";
+      return 1;
+    }
+    if (file)
+    {
+      return bukreev::runFile(argv[2], std::cout, excsndLatrmvKeep.bits, workers);
+    }
+    return bukreev::runBatch(std::cin, std::cout, excsndLatrmvKeep.bits, workers);
+  }
+
+  bool cyrillic = argc > 1 && std::strcmp(argv[1], "--cyrillic") == 0;
   size_t len = 0;
 
-  char* str = bukreev::inputString(std::cin, len);
+  char* str = bukreev::excsndLatrmvStream(std::cin, std::cout, excsndLatrmvKeep.bits, len);
   if (!str)
   {
     std::cerr << "Not enough memory for string input.\n";
@@ -30,157 +88,386 @@ int main()
     std::cerr << "The string is empty.\n";
     return 2;
   }
+  std::cout << '\n';
+  if (cyrillic)
+  {
+    bukreev::latrmvUtf8(str, std::strlen(str), str, true);
+  }
+
+  {
+    PROBE_SCOPE("output");
+    PROBE_COUNT("bytes written", std::strlen(str) + 1);
+    std::cout << str << '\n';
+  }
+
+  free(str);
+}
 
-  size_t allocSize = (len + 1) * sizeof(char);
+char* bukreev::excsndLatrmvStream(std::istream& in, std::ostream& out, const unsigned char* keep, size_t& len)
+{
+  PROBE_SCOPE("excsndLatrmvStream");
 
-  char* res1 = reinterpret_cast< char* >(malloc(allocSize));
-  if (!res1)
+  size_t capacity = chunkSize;
+  char* buffer = reinterpret_cast< char* >(malloc((capacity + 1) * sizeof(char)));
+  if (!buffer)
   {
-    std::cerr << "Not enough memory for EXC_SND.\n";
-    free(str);
-    return 1;
+    return nullptr;
   }
-  res1[len] = '\0';
 
-  char* res2 = reinterpret_cast< char* >(malloc(allocSize));
-  if (!res2)
+  char filtered[chunkSize];
+  size_t resLen = 0;
+  len = 0;
+  bool done = false;
+  while (!done)
   {
-    std::cerr << "Not enough memory for LAT_RMV.\n";
-    free(str);
-    free(res1);
-    return 1;
+    if (capacity - resLen < chunkSize)
+    {
+      char* newBuffer = reinterpret_cast< char* >(realloc(buffer, (capacity * 2 + 1) * sizeof(char)));
+      if (!newBuffer)
+      {
+        free(buffer);
+        return nullptr;
+      }
+      PROBE_COUNT("reallocations", 1);
+      buffer = newBuffer;
+      capacity *= 2;
+    }
+
+    char* chunk = buffer + resLen;
+    size_t got = 0;
+    lineread::Block block = lineread::readBlock(in, chunk, chunkSize, got);
+    if (block == lineread::Block::failed)
+    {
+      free(buffer);
+      return nullptr;
+    }
+    done = (block == lineread::Block::last);
+
+    const char* end = reinterpret_cast< const char* >(std::memchr(chunk, '\0', got));
+    if (end)
+    {
+      got = end - chunk;
+      done = true;
+    }
+
+    size_t excLen = 0;
+    size_t latLen = 0;
+    excsndLatrmv(chunk, got, keep, filtered, excLen, chunk, latLen);
+    out.write(filtered, excLen);
+    resLen += latLen;
+    len += got;
   }
-  res2[len] = '\0';
 
-  const char* stringToExclude = "abc";
+  PROBE_COUNT("bytes read", len);
+  buffer[resLen] = '\0';
+  return buffer;
+}
+
+size_t bukreev::latrmvAscii(const char* str, size_t len, char* resStr)
+{
+  return ascii::removeLatin(str, len, resStr);
+}
+
+char* bukreev::latrmvUtf8(const char* str, size_t len, char* resStr, bool cyrillic)
+{
+  PROBE_SCOPE("latrmvUtf8");
+  size_t resIndex = 0;
+  size_t i = 0;
 
-  res1 = bukreev::excsnd(str, stringToExclude, res1);
-  res2 = bukreev::latrmv(str, res2);
+  while (i < len)
+  {
+    size_t ascii = utf8::asciiPrefix(str + i, len - i);
+    resIndex += latrmvAscii(str + i, ascii, resStr + resIndex);
+    i += ascii;
+    if (i == len)
+    {
+      break;
+    }
 
-  free(str);
+    unsigned long codePoint = 0;
+    size_t size = utf8::decode(str + i, len - i, codePoint);
+    if (size == 0)
+    {
+      resStr[resIndex++] = str[i++];
+      continue;
+    }
+    if (!cyrillic || utf8::cyrillicIndex(codePoint) < 0)
+    {
+      std::memmove(resStr + resIndex, str + i, size);
+      resIndex += size;
+    }
+    i += size;
+  }
 
-  std::cout << res1 << '\n';
-  std::cout << res2 << '\n';
+  resStr[resIndex] = '\0';
 
-  free(res1);
-  free(res2);
+  return resStr;
 }
 
-char* bukreev::inputString(std::istream& in, size_t& len)
+void bukreev::excsndLatrmv(const char* str, size_t len, const unsigned char* keep, char* excRes, size_t& excLen, char* latRes, size_t& latLen)
 {
-  size_t capacity = initialSize;
+  size_t excIndex = 0;
+  size_t latIndex = 0;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    char c = str[i];
+    unsigned char k = keep[static_cast< unsigned char >(c)];
+    excRes[excIndex] = c;
+    excIndex += k & 1;
+    latRes[latIndex] = c;
+    latIndex += (k >> 1) & 1;
+  }
+
+  excLen = excIndex;
+  latLen = latIndex;
+}
 
-  char* buffer = reinterpret_cast< char* >(malloc(initialSize * sizeof(char)));
+char* bukreev::readAll(std::istream& in, size_t& len)
+{
+  PROBE_SCOPE("readAll");
+  size_t capacity = chunkSize;
+  char* buffer = reinterpret_cast< char* >(malloc(capacity * sizeof(char)));
   if (!buffer)
   {
     return nullptr;
   }
 
-  in >> std::noskipws;
-
-  size_t size;
-  char c = ' ';
-  for (size = 0; in && c != '\0'; size++)
+  len = 0;
+  while (in)
   {
-    if (size >= capacity)
+    if (capacity - len < chunkSize)
     {
-      char* oldBuffer = buffer;
-      buffer = growString(buffer, capacity);
-      free(oldBuffer);
-
-      if (!buffer)
+      char* newBuffer = reinterpret_cast< char* >(realloc(buffer, capacity * 2 * sizeof(char)));
+      if (!newBuffer)
       {
-        in >> std::skipws;
+        free(buffer);
         return nullptr;
       }
+      buffer = newBuffer;
+      capacity *= 2;
     }
+    in.read(buffer + len, capacity - len);
+    len += in.gcount();
+  }
 
-    in >> c;
-    c = (c == '\n' ? '\0' : c);
-    buffer[size] = c;
+  if (!in.eof())
+  {
+    free(buffer);
+    return nullptr;
   }
-  size--;
+  return buffer;
+}
 
-  if (!in)
+size_t bukreev::excsndLatrmvLines(const char* begin, const char* end, const unsigned char* keep, char* out, size_t& empty)
+{
+  size_t outLen = 0;
+  empty = 0;
+  while (begin != end)
   {
-    if (in.eof())
+    const char* newline = reinterpret_cast< const char* >(std::memchr(begin, '\n', end - begin));
+    const char* lineEnd = newline ? newline : end;
+    const char* nul = reinterpret_cast< const char* >(std::memchr(begin, '\0', lineEnd - begin));
+    size_t len = (nul ? nul : lineEnd) - begin;
+    if (len == 0)
     {
-      buffer[size] = '\0';
+      empty++;
     }
     else
     {
-      in >> std::skipws;
-      free(buffer);
-      return nullptr;
+      char* excRes = out + outLen;
+      char* latRes = excRes + len + 1;
+      size_t excLen = 0;
+      size_t latLen = 0;
+      excsndLatrmv(begin, len, keep, excRes, excLen, latRes, latLen);
+      excRes[excLen] = '\n';
+      std::memmove(excRes + excLen + 1, latRes, latLen);
+      excRes[excLen + 1 + latLen] = '\n';
+      outLen += excLen + latLen + 2;
     }
-  }
 
-  in >> std::skipws;
-  len = size;
-  return buffer;
+    begin = newline ? newline + 1 : end;
+  }
+  return outLen;
 }
 
-char* bukreev::growString(const char* oldStr, size_t& capacity)
+bool bukreev::parseWorkers(const char* arg, size_t& workers)
 {
-  constexpr double growRatio = 1.5;
-  size_t newCapacity = capacity * growRatio;
+  size_t hardware = std::thread::hardware_concurrency();
+  hardware = hardware == 0 ? 1 : hardware;
+  if (!arg)
+  {
+    workers = hardware;
+    return true;
+  }
+  if (*arg < '0' || *arg > '9')
+  {
+    return false;
+  }
+  errno = 0;
+  char* end = nullptr;
+  unsigned long long count = std::strtoull(arg, &end, 10);
+  if (*end != '\0' || errno == ERANGE || count == 0)
+  {
+    return false;
+  }
+  workers = count < hardware ? count : hardware;
+  return true;
+}
 
-  char* newStr = reinterpret_cast< char* >(malloc(newCapacity * sizeof(char)));
-  if (!newStr)
+int bukreev::runBatch(std::istream& in, std::ostream& out, const unsigned char* keep, size_t workers)
+{
+  PROBE_SCOPE("runBatch");
+  size_t len = 0;
+  char* input = readAll(in, len);
+  if (!input)
   {
-    return nullptr;
+    std::cerr << "Not enough memory for string input.\n";
+    return 1;
   }
 
-  std::strncpy(newStr, oldStr, capacity);
-  capacity = newCapacity;
+  int status = runLines(input, len, out, keep, workers);
+  free(input);
+  return status;
+}
 
-  return newStr;
+int bukreev::runFile(const char* path, std::ostream& out, const unsigned char* keep, size_t workers)
+{
+  PROBE_SCOPE("runFile");
+  linemap::File file;
+  if (!file.open(path))
+  {
+    std::cerr << "Cannot open " << path << ".\n";
+    return 1;
+  }
+  return runLines(file.begin(), file.size(), out, keep, workers);
 }
 
-char* bukreev::excsnd(const char* first, const char* second, char* resStr)
+int bukreev::runLines(const char* input, size_t len, std::ostream& out, const unsigned char* keep, size_t workers)
 {
-  size_t resIndex = 0;
+  if (len == 0)
+  {
+    std::cerr << "The string is empty.\n";
+    return 2;
+  }
+
+  size_t lines = 0;
+  for (const char* pos = input; pos != input + len && lines < workers; lines++)
+  {
+    const char* newline = reinterpret_cast< const char* >(std::memchr(pos, '\n', input + len - pos));
+    pos = newline ? newline + 1 : input + len;
+  }
+  workers = lines < workers ? (lines == 0 ? 1 : lines) : workers;
 
-  for (size_t i = 0; first[i] != '\0'; i++)
+  std::vector< const char* > bounds(workers + 1, input + len);
+  bounds[0] = input;
+  for (size_t i = 1; i < workers; i++)
   {
-    char c = first[i];
-    bool exclude = false;
+    const char* split = input + len / workers * i;
+    if (split < bounds[i - 1])
+    {
+      split = bounds[i - 1];
+    }
+    const char* newline = reinterpret_cast< const char* >(std::memchr(split, '\n', input + len - split));
+    bounds[i] = newline ? newline + 1 : input + len;
+  }
+
+  std::vector< char* > outputs(workers, nullptr);
+  std::vector< size_t > outputLens(workers, 0);
+  std::vector< size_t > emptyLines(workers, 0);
+  bool failed = false;
+  for (size_t i = 0; i < workers; i++)
+  {
+    outputs[i] = reinterpret_cast< char* >(malloc((4 * (bounds[i + 1] - bounds[i]) + 2) * sizeof(char)));
+    failed = failed || !outputs[i];
+  }
 
-    for (size_t j = 0; second[j] != '\0'; j++)
+  size_t empty = 0;
+  if (!failed)
+  {
+    auto work = [&](size_t i)
+    {
+      outputLens[i] = excsndLatrmvLines(bounds[i], bounds[i + 1], keep, outputs[i], emptyLines[i]);
+    };
+    std::vector< std::thread > threads;
+    std::vector< size_t > pending;
+    for (size_t i = 1; i < workers; i++)
     {
-      if (second[j] == c)
+      try
+      {
+        threads.emplace_back(work, i);
+      }
+      catch (const std::system_error&)
       {
-        exclude = true;
-        break;
+        pending.push_back(i);
       }
     }
-
-    if (!exclude)
+    work(0);
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+      work(pending[i]);
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+      threads[i].join();
+    }
+    for (size_t i = 0; i < workers; i++)
     {
-      resStr[resIndex] = c;
-      resIndex++;
+      out.write(outputs[i], outputLens[i]);
+      empty += emptyLines[i];
     }
   }
 
-  resStr[resIndex] = '\0';
-
-  return resStr;
+  for (size_t i = 0; i < workers; i++)
+  {
+    free(outputs[i]);
+  }
+  if (failed)
+  {
+    std::cerr << "Not enough memory for batch output.\n";
+    return 1;
+  }
+  if (empty != 0)
+  {
+    std::cerr << "The string is empty.\n";
+    return 2;
+  }
+  return 0;
 }
 
-char* bukreev::latrmv(const char* str, char* resStr)
+int bukreev::runStrip(std::istream& in, std::ostream& out, const char* const* patterns, size_t count)
 {
-  size_t resIndex = 0;
-
-  for (size_t i = 0; str[i] != '\0'; i++)
+  PROBE_SCOPE("runStrip");
+  size_t len = 0;
+  char* str = lineread::getline(in, len);
+  if (!str)
   {
-    if (!std::isalpha(str[i]))
-    {
-      resStr[resIndex] = str[i];
-      resIndex++;
-    }
+    std::cerr << "Not enough memory for string input.\n";
+    return 1;
+  }
+  if (len == 0)
+  {
+    free(str);
+    std::cerr << "The string is empty.\n";
+    return 2;
   }
 
-  resStr[resIndex] = '\0';
+  size_t found = 0;
+  try
+  {
+    acmatch::Automaton automaton(patterns, count);
+    found = automaton.count(str, len);
+    len = automaton.remove(str, len, str);
+  }
+  catch (const std::bad_alloc&)
+  {
+    free(str);
+    std::cerr << "Not enough memory for the patterns.\n";
+    return 1;
+  }
 
-  return resStr;
+  out.write(str, len);
+  out << '\n' << found << '\n';
+  free(str);
+  return 0;
 }
@@ -2,34 +2,45 @@
 #include <iomanip>
 #include <cstring>
 #include <cctype>
+#include <cstdlib>
+#include <charset.hpp>
+#include <linemap.hpp>
+#include <lineread.hpp>
 namespace chernikov
 {
-  char *getline(std::istream &in, size_t &len);
-  size_t hasSam(const char *str1, const char *str2);
+  size_t hasSam(const char *str1, size_t len1, const char *str2);
   void uniTwo(char *uni_two, const char *str1, const char *str2, size_t len1, size_t len2);
+  int printResults(const char *str1, size_t len1);
+  int runFile(const char *path);
 }
-int main()
+int main(int argc, char *argv[])
 {
-  char *str1 = nullptr;
+  if (argc > 2 && std::strcmp(argv[1], "--file") == 0)
+  {
+    return chernikov::runFile(argv[2]);
+  }
   size_t len1 = 0;
-  try
+  char *str1 = lineread::getline(std::cin, len1);
+  if (str1 == nullptr)
   {
-    str1 = chernikov::getline(std::cin, len1);
-    if (str1[0] == '\0')
-    {
-      std::cerr << "Error: empty inputt\n";
-      delete[] str1;
-      return 1;
-    }
+    std::cerr << "Memory allocation or string allocation error\n";
+    return 1;
   }
-  catch (const std::bad_alloc &e)
+  if (str1[0] == '\0' || std::cin.eof())
   {
-    std::cerr << "Memory allocation or string allocation error" << e.what() << "\n";
-    delete[] str1;
+    std::cerr << "Error: empty inputt\n";
+    std::free(str1);
     return 1;
   }
+  int status = chernikov::printResults(str1, len1);
+  std::free(str1);
+  return status;
+}
+
+int chernikov::printResults(const char *str1, size_t len1)
+{
   const char *str2 = "example";
-  size_t has_sam = chernikov::hasSam(str1, str2);
+  size_t has_sam = hasSam(str1, len1, str2);
   size_t len2 = std::strlen(str2);
   size_t max_result_size = len1 + len2 + 1;
   char *uni_two = nullptr;
@@ -41,85 +52,38 @@ int main()
   catch (const std::bad_alloc &e)
   {
     std::cerr << "Memory allocationfailed: " << e.what() << "\n";
-    delete[] str1;
     return 1;
   }
-  chernikov::uniTwo(uni_two, str1, str2, len1, len2);
+  uniTwo(uni_two, str1, str2, len1, len2);
   std::cout << "HAS-SAM: " << std::boolalpha << has_sam << '\n';
   std::cout << "UNI_TWO: " << uni_two << '\n';
-
-  delete[] str1;
   delete[] uni_two;
   return 0;
 }
 
-char *chernikov::getline(std::istream &in, size_t &len)
+int chernikov::runFile(const char *path)
 {
-  bool is_skipws = in.flags() & std::ios_base::skipws;
-  if (is_skipws)
-  {
-    in >> std::noskipws;
-  }
-  char ch;
-  len = 0;
-  char *data = nullptr;
-  try
+  linemap::File file;
+  if (!file.open(path))
   {
-    while (in.good() && in >> ch && ch != '\n')
-    {
-      char *new_data = new char[len + 2];
-      for (size_t i = 0; i < len; ++i)
-      {
-        new_data[i] = data[i];
-      }
-      new_data[len] = ch;
-      new_data[len + 1] = '\0';
-      delete[] data;
-      data = new_data;
-      len++;
-    }
-  }
-  catch (const std::bad_alloc &e)
-  {
-    delete[] data;
-    if (is_skipws)
-    {
-      in >> std::skipws;
-    }
-    throw;
-  }
-  if (!in.good() || in.eof())
-  {
-    len = 0;
-    delete[] data;
-    data = new char[1];
-    data[0] = '\0';
-    return data;
-  }
-  if (data == nullptr)
-  {
-    data = new char[1];
-    data[0] = '\0';
+    std::cerr << "Error: cannot open " << path << "\n";
+    return 1;
   }
-  if (is_skipws)
+  const char *pos = file.begin();
+  linemap::span_t line = {};
+  bool found = linemap::nextLine(pos, file.end(), line);
+  if (!found || line.len == 0 || line.begin[0] == '\0' || line.begin + line.len == file.end())
   {
-    in >> std::skipws;
+    std::cerr << "Error: empty inputt\n";
+    return 1;
   }
-  return data;
+  return printResults(line.begin, line.len);
 }
-size_t chernikov::hasSam(const char *str1, const char *str2)
+
+size_t chernikov::hasSam(const char *str1, size_t len1, const char *str2)
 {
-  for (size_t i = 0; str1[i] != '\0'; ++i)
-  {
-    for (size_t j = 0; str2[j] != '\0'; ++j)
-    {
-      if (str1[i] == str2[j])
-      {
-        return 1;
-      }
-    }
-  }
-  return 0;
+  charset::table_t common = charset::intersect(charset::fromBytes(str1, len1), charset::fromString(str2));
+  return charset::isEmpty(common) ? 0 : 1;
 }
 void chernikov::uniTwo(char *uni_two, const char *str1, const char *str2, size_t len1, size_t len2)
 {
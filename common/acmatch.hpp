@@ -0,0 +1,145 @@
+#ifndef ACMATCH_HPP
+#define ACMATCH_HPP
+
+// Multi-pattern substring matching (Aho-Corasick) over raw char buffers.
+// The automaton is a dense table of 256 transitions per state, so a scan
+// is one table load per input byte regardless of the number of patterns.
+// remove() drops every byte covered by at least one occurrence (overlaps
+// included) and count() returns the number of occurrences.
+
+#include <cstddef>
+#include <vector>
+
+namespace acmatch
+{
+  class Automaton
+  {
+  public:
+    Automaton(const char* const* patterns, size_t count):
+      next_(alphabet, -1),
+      longest_(1, 0),
+      matches_(1, 0),
+      maxLength_(0)
+    {
+      for (size_t p = 0; p < count; p++)
+      {
+        size_t state = 0;
+        size_t len = 0;
+        for (; patterns[p][len] != '\0'; len++)
+        {
+          unsigned char c = static_cast< unsigned char >(patterns[p][len]);
+          if (next_[state * alphabet + c] < 0)
+          {
+            next_[state * alphabet + c] = static_cast< int >(longest_.size());
+            next_.resize(next_.size() + alphabet, -1);
+            longest_.push_back(0);
+            matches_.push_back(0);
+          }
+          state = next_[state * alphabet + c];
+        }
+        if (len != 0)
+        {
+          longest_[state] = len;
+          matches_[state]++;
+          maxLength_ = len > maxLength_ ? len : maxLength_;
+        }
+      }
+      link();
+    }
+
+    size_t states() const
+    {
+      return longest_.size();
+    }
+
+    size_t remove(const char* str, size_t len, char* res) const
+    {
+      // kept[j & mask] is the output length before input byte j; matches
+      // are at most maxLength_ long, so a ring of that size is enough.
+      size_t mask = 1;
+      while (mask <= maxLength_)
+      {
+        mask <<= 1;
+      }
+      std::vector< size_t > kept(mask--, 0);
+
+      size_t state = 0;
+      size_t k = 0;
+      for (size_t i = 0; i < len; i++)
+      {
+        state = next_[state * alphabet + static_cast< unsigned char >(str[i])];
+        kept[i & mask] = k;
+        res[k++] = str[i];
+        size_t match = longest_[state];
+        if (match != 0)
+        {
+          k = kept[(i + 1 - match) & mask];
+          for (size_t j = i + 1 - match; j <= i; j++)
+          {
+            kept[j & mask] = k;
+          }
+        }
+      }
+      return k;
+    }
+
+    size_t count(const char* str, size_t len) const
+    {
+      size_t state = 0;
+      size_t total = 0;
+      for (size_t i = 0; i < len; i++)
+      {
+        state = next_[state * alphabet + static_cast< unsigned char >(str[i])];
+        total += matches_[state];
+      }
+      return total;
+    }
+
+  private:
+    static const size_t alphabet = 256;
+
+    std::vector< int > next_;
+    std::vector< size_t > longest_;
+    std::vector< size_t > matches_;
+    size_t maxLength_;
+
+    void link()
+    {
+      std::vector< size_t > fail(longest_.size(), 0);
+      std::vector< size_t > queue;
+      for (size_t c = 0; c < alphabet; c++)
+      {
+        if (next_[c] < 0)
+        {
+          next_[c] = 0;
+        }
+        else
+        {
+          queue.push_back(next_[c]);
+        }
+      }
+      for (size_t head = 0; head < queue.size(); head++)
+      {
+        size_t state = queue[head];
+        size_t back = fail[state];
+        longest_[state] = longest_[state] != 0 ? longest_[state] : longest_[back];
+        matches_[state] += matches_[back];
+        for (size_t c = 0; c < alphabet; c++)
+        {
+          int& to = next_[state * alphabet + c];
+          if (to < 0)
+          {
+            to = next_[back * alphabet + c];
+          }
+          else
+          {
+            fail[to] = next_[back * alphabet + c];
+            queue.push_back(to);
+          }
+        }
+      }
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef ASCII_HPP
+#define ASCII_HPP
+
+// Locale-independent classification of ASCII Latin letters. A byte is a
+// letter when its 0x20-folded value lies in 'a'..'z', so every test is one
+// OR and one unsigned range compare. Bytes of multibyte UTF-8 sequences
+// (0x80 and up) never match. The bulk helpers process 16 bytes at a time
+// with SSE2 where the compiler targets it and give byte-identical results
+// through the scalar loop elsewhere.
+
+#include <cstddef>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace ascii
+{
+  constexpr size_t latinCount = 26;
+
+  // Position of the letter in the alphabet; latinCount or more for any
+  // other byte.
+  constexpr unsigned char latinIndex(char c)
+  {
+    return static_cast< unsigned char >((static_cast< unsigned char >(c) | 0x20) - 'a');
+  }
+
+  constexpr bool isLatin(char c)
+  {
+    return latinIndex(c) < latinCount;
+  }
+
+  constexpr bool isUpper(char c)
+  {
+    return static_cast< unsigned char >(static_cast< unsigned char >(c) - 'A') < latinCount;
+  }
+
+  constexpr char toLower(char c)
+  {
+    return static_cast< char >(static_cast< unsigned char >(c) | (isUpper(c) << 5));
+  }
+
+  // Bit latinIndex(c) is set for every letter of str, regardless of case.
+  // Stops early once all 26 bits are set, checking every 32 bytes.
+  inline unsigned long latinMask(const char* str, size_t len)
+  {
+    const unsigned long allLetters = (1ul << latinCount) - 1;
+    unsigned long mask = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+      unsigned char index = latinIndex(str[i]);
+      mask |= static_cast< unsigned long >(index < latinCount) << (index & 31);
+      if ((i & 31) == 31 && mask == allLetters)
+      {
+        break;
+      }
+    }
+    return mask;
+  }
+
+  // Writes len bytes of src to dst with upper-case letters lowered. dst may
+  // be src.
+  inline void toLower(const char* src, size_t len, char* dst)
+  {
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i bias = _mm_set1_epi8(static_cast< char >(128 - 'A'));
+    const __m128i limit = _mm_set1_epi8(static_cast< char >(-128 + static_cast< int >(latinCount)));
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= len; i += 16)
+    {
+      __m128i block = _mm_loadu_si128(reinterpret_cast< const __m128i* >(src + i));
+      __m128i upper = _mm_cmplt_epi8(_mm_add_epi8(block, bias), limit);
+      block = _mm_or_si128(block, _mm_and_si128(upper, caseBit));
+      _mm_storeu_si128(reinterpret_cast< __m128i* >(dst + i), block);
+    }
+#endif
+    for (; i < len; ++i)
+    {
+      dst[i] = toLower(src[i]);
+    }
+  }
+
+  // Copies the bytes of src that are not letters to dst and returns how
+  // many were kept. dst needs room for len bytes and may be src.
+  inline size_t removeLatin(const char* src, size_t len, char* dst)
+  {
+    size_t kept = 0;
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i bias = _mm_set1_epi8(static_cast< char >(128 - 'a'));
+    const __m128i limit = _mm_set1_epi8(static_cast< char >(-128 + static_cast< int >(latinCount)));
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= len; i += 16)
+    {
+      __m128i block = _mm_loadu_si128(reinterpret_cast< const __m128i* >(src + i));
+      __m128i folded = _mm_or_si128(block, caseBit);
+      __m128i latin = _mm_cmplt_epi8(_mm_add_epi8(folded, bias), limit);
+      if (_mm_movemask_epi8(latin) == 0)
+      {
+        _mm_storeu_si128(reinterpret_cast< __m128i* >(dst + kept), block);
+        kept += 16;
+        continue;
+      }
+      for (size_t j = i; j < i + 16; ++j)
+      {
+        dst[kept] = src[j];
+        kept += !isLatin(src[j]);
+      }
+    }
+#endif
+    for (; i < len; ++i)
+    {
+      dst[kept] = src[i];
+      kept += !isLatin(src[i]);
+    }
+    return kept;
+  }
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef BUFPOOL_HPP
+#define BUFPOOL_HPP
+
+// Recycling pool for char buffers that are allocated and freed once per
+// line or word. acquire()/release() replace a malloc()/free() pair.
+// Requests are rounded up to power-of-two size classes from 32 bytes to
+// 1 MiB; released buffers are kept in a per-thread free list of their
+// class, so the fast path takes no locks. Larger buffers go straight to
+// malloc. Buffers may be released on any thread.
+
+#include <cstddef>
+#include <cstdlib>
+
+namespace bufpool
+{
+  struct stats_t
+  {
+    size_t acquires;
+    size_t hits;
+    size_t releases;
+    size_t bytesRetained;
+  };
+
+  namespace detail
+  {
+    constexpr size_t minShift = 5;
+    constexpr size_t classCount = 16;
+    constexpr size_t maxCached = 8;
+    constexpr size_t headerSize = 16;
+    constexpr size_t unpooled = classCount;
+
+    struct node_t
+    {
+      node_t* next;
+    };
+
+    class Cache
+    {
+    public:
+      Cache():
+        heads_(),
+        counts_(),
+        stats_()
+      {}
+
+      Cache(const Cache&) = delete;
+      Cache& operator=(const Cache&) = delete;
+
+      ~Cache()
+      {
+        for (size_t c = 0; c < classCount; c++)
+        {
+          while (heads_[c])
+          {
+            node_t* node = heads_[c];
+            heads_[c] = node->next;
+            std::free(reinterpret_cast< char* >(node) - headerSize);
+          }
+        }
+      }
+
+      char* acquire(size_t size)
+      {
+        stats_.acquires++;
+        size_t cls = 0;
+        while (cls < classCount && (static_cast< size_t >(1) << (cls + minShift)) < size)
+        {
+          cls++;
+        }
+        if (cls < classCount && heads_[cls])
+        {
+          node_t* node = heads_[cls];
+          heads_[cls] = node->next;
+          counts_[cls]--;
+          stats_.hits++;
+          stats_.bytesRetained -= classBytes(cls);
+          return reinterpret_cast< char* >(node);
+        }
+        size_t bytes = cls < classCount ? classBytes(cls) : size;
+        char* block = static_cast< char* >(std::malloc(headerSize + bytes));
+        if (!block)
+        {
+          return nullptr;
+        }
+        *reinterpret_cast< size_t* >(block) = cls;
+        return block + headerSize;
+      }
+
+      void release(char* buffer)
+      {
+        if (!buffer)
+        {
+          return;
+        }
+        stats_.releases++;
+        size_t cls = *reinterpret_cast< size_t* >(buffer - headerSize);
+        if (cls == unpooled || counts_[cls] == maxCached)
+        {
+          std::free(buffer - headerSize);
+          return;
+        }
+        node_t* node = reinterpret_cast< node_t* >(buffer);
+        node->next = heads_[cls];
+        heads_[cls] = node;
+        counts_[cls]++;
+        stats_.bytesRetained += classBytes(cls);
+      }
+
+      stats_t stats() const
+      {
+        return stats_;
+      }
+
+    private:
+      node_t* heads_[classCount];
+      size_t counts_[classCount];
+      stats_t stats_;
+
+      static size_t classBytes(size_t cls)
+      {
+        return static_cast< size_t >(1) << (cls + minShift);
+      }
+    };
+
+    inline Cache& cache()
+    {
+      thread_local Cache instance;
+      return instance;
+    }
+  }
+
+  inline char* acquire(size_t size)
+  {
+    return detail::cache().acquire(size);
+  }
+
+  inline void release(char* buffer)
+  {
+    detail::cache().release(buffer);
+  }
+
+  // Counters of the calling thread's cache.
+  inline stats_t stats()
+  {
+    return detail::cache().stats();
+  }
+}
+
+#endif
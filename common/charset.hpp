@@ -0,0 +1,150 @@
+#ifndef CHARSET_HPP
+#define CHARSET_HPP
+
+// Byte-class tables built at compile time from string literals, or at run
+// time from input strings. A table holds one byte of flags per character,
+// so several literals can share one table under different bits and a
+// filter loop needs a single lookup per input byte:
+//   constexpr charset::table_t vowels = charset::fromLiteral("aeiou");
+//   keep = !vowels.bits[static_cast< unsigned char >(c)];
+// The set operations combine two tables flag by flag, which turns the
+// "characters common to both strings" kind of question into one pass over
+// each string plus a fixed 256-byte step.
+
+#include <cstddef>
+
+namespace charset
+{
+  constexpr size_t charCount = 256;
+
+  struct table_t
+  {
+    unsigned char bits[charCount];
+  };
+
+  template< size_t N >
+  constexpr table_t withLiteral(table_t table, const char (&literal)[N], unsigned char bit = 1)
+  {
+    for (size_t i = 0; i + 1 < N; i++)
+    {
+      table.bits[static_cast< unsigned char >(literal[i])] |= bit;
+    }
+    return table;
+  }
+
+  template< size_t N >
+  constexpr table_t fromLiteral(const char (&literal)[N], unsigned char bit = 1)
+  {
+    return withLiteral(table_t{}, literal, bit);
+  }
+
+  constexpr table_t withBytes(table_t table, const char* str, size_t len, unsigned char bit = 1)
+  {
+    for (size_t i = 0; i < len; i++)
+    {
+      table.bits[static_cast< unsigned char >(str[i])] |= bit;
+    }
+    return table;
+  }
+
+  constexpr table_t fromBytes(const char* str, size_t len, unsigned char bit = 1)
+  {
+    return withBytes(table_t{}, str, len, bit);
+  }
+
+  constexpr table_t withString(table_t table, const char* str, unsigned char bit = 1)
+  {
+    for (size_t i = 0; str[i] != '\0'; i++)
+    {
+      table.bits[static_cast< unsigned char >(str[i])] |= bit;
+    }
+    return table;
+  }
+
+  constexpr table_t fromString(const char* str, unsigned char bit = 1)
+  {
+    return withString(table_t{}, str, bit);
+  }
+
+  constexpr table_t unite(table_t lhs, const table_t& rhs)
+  {
+    for (size_t c = 0; c < charCount; c++)
+    {
+      lhs.bits[c] |= rhs.bits[c];
+    }
+    return lhs;
+  }
+
+  constexpr table_t intersect(table_t lhs, const table_t& rhs)
+  {
+    for (size_t c = 0; c < charCount; c++)
+    {
+      lhs.bits[c] &= rhs.bits[c];
+    }
+    return lhs;
+  }
+
+  constexpr table_t subtract(table_t lhs, const table_t& rhs)
+  {
+    for (size_t c = 0; c < charCount; c++)
+    {
+      lhs.bits[c] &= ~rhs.bits[c];
+    }
+    return lhs;
+  }
+
+  constexpr table_t symmetricDifference(table_t lhs, const table_t& rhs)
+  {
+    for (size_t c = 0; c < charCount; c++)
+    {
+      lhs.bits[c] ^= rhs.bits[c];
+    }
+    return lhs;
+  }
+
+  constexpr bool isEmpty(const table_t& table)
+  {
+    unsigned char any = 0;
+    for (size_t c = 0; c < charCount; c++)
+    {
+      any |= table.bits[c];
+    }
+    return any == 0;
+  }
+
+  constexpr table_t invert(table_t table, unsigned char bit = 1)
+  {
+    for (size_t c = 0; c < charCount; c++)
+    {
+      table.bits[c] ^= bit;
+    }
+    return table;
+  }
+
+  constexpr table_t withLatin(table_t table, unsigned char bit = 1)
+  {
+    for (size_t c = 'A'; c <= 'Z'; c++)
+    {
+      table.bits[c] |= bit;
+      table.bits[c | 0x20] |= bit;
+    }
+    return table;
+  }
+
+  template< size_t N >
+  constexpr unsigned long latinMask(const char (&literal)[N])
+  {
+    unsigned long mask = 0;
+    for (size_t i = 0; i + 1 < N; i++)
+    {
+      unsigned char index = (static_cast< unsigned char >(literal[i]) | 0x20) - 'a';
+      if (index < 26)
+      {
+        mask |= 1ul << index;
+      }
+    }
+    return mask;
+  }
+}
+
+#endif
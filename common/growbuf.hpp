@@ -0,0 +1,205 @@
+#ifndef GROWBUF_HPP
+#define GROWBUF_HPP
+
+// Growable byte buffer with a pluggable growth policy.
+// A policy is a type with a static function
+//   size_t next(size_t capacity, size_t required)
+// that returns the new capacity (at least required). Storage is managed
+// with realloc, so the allocator can extend a block in place; the buffer
+// counts reallocations and the bytes that had to be moved to a new block.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+namespace growbuf
+{
+  template< size_t Num, size_t Den >
+  struct Geometric
+  {
+    static_assert(Num > Den, "growth factor must be greater than one");
+
+    static size_t next(size_t capacity, size_t required)
+    {
+      size_t grown = capacity / Den * Num + capacity % Den * Num / Den;
+      if (grown <= capacity)
+      {
+        grown = capacity + 1;
+      }
+      return grown < required ? required : grown;
+    }
+  };
+
+  template< size_t Step >
+  struct FixedStep
+  {
+    static_assert(Step > 0, "growth step must be positive");
+
+    static size_t next(size_t capacity, size_t required)
+    {
+      size_t grown = capacity + Step;
+      return grown < required ? required : grown;
+    }
+  };
+
+  // Rounds the request up to a jemalloc-style size class: multiples of 16
+  // up to 128 bytes, then four classes per power of two. Growing to a class
+  // boundary never leaves allocator slack unused.
+  struct SizeClass
+  {
+    static size_t next(size_t capacity, size_t required)
+    {
+      size_t want = capacity + capacity / 2;
+      if (want < required)
+      {
+        want = required;
+      }
+      if (want <= 128)
+      {
+        return (want + 15) & ~static_cast< size_t >(15);
+      }
+      size_t group = 128;
+      while (group * 2 < want)
+      {
+        group *= 2;
+      }
+      size_t step = group / 4;
+      return (want + step - 1) / step * step;
+    }
+  };
+
+  template< class Policy >
+  class Buffer
+  {
+  public:
+    explicit Buffer(size_t initialCapacity = 16):
+      data_(nullptr),
+      size_(0),
+      capacity_(0),
+      reallocations_(0),
+      bytesCopied_(0),
+      initial_(initialCapacity == 0 ? 1 : initialCapacity)
+    {}
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    ~Buffer()
+    {
+      std::free(data_);
+    }
+
+    bool reserve(size_t required)
+    {
+      if (required <= capacity_)
+      {
+        return true;
+      }
+      size_t newCapacity = capacity_ == 0 ? initial_ : Policy::next(capacity_, required);
+      if (newCapacity < required)
+      {
+        newCapacity = required;
+      }
+      char* moved = static_cast< char* >(std::realloc(data_, newCapacity));
+      if (!moved)
+      {
+        return false;
+      }
+      if (data_)
+      {
+        reallocations_++;
+        if (moved != data_)
+        {
+          bytesCopied_ += size_;
+        }
+      }
+      data_ = moved;
+      capacity_ = newCapacity;
+      return true;
+    }
+
+    bool push(char c)
+    {
+      if (size_ == capacity_ && !reserve(size_ + 1))
+      {
+        return false;
+      }
+      data_[size_++] = c;
+      return true;
+    }
+
+    bool append(const char* src, size_t len)
+    {
+      if (!reserve(size_ + len))
+      {
+        return false;
+      }
+      std::memcpy(data_ + size_, src, len);
+      size_ += len;
+      return true;
+    }
+
+    // Sets the size after bytes were written straight into data(); size
+    // must not exceed capacity().
+    void resize(size_t size)
+    {
+      size_ = size;
+    }
+
+    void clear()
+    {
+      size_ = 0;
+    }
+
+    // Hands the storage to the caller (to be released with free) and
+    // leaves the buffer empty. The returned string is NUL-terminated.
+    char* release()
+    {
+      if (!reserve(size_ + 1))
+      {
+        return nullptr;
+      }
+      data_[size_] = '\0';
+      char* result = data_;
+      data_ = nullptr;
+      size_ = 0;
+      capacity_ = 0;
+      return result;
+    }
+
+    char* data() const
+    {
+      return data_;
+    }
+
+    size_t size() const
+    {
+      return size_;
+    }
+
+    size_t capacity() const
+    {
+      return capacity_;
+    }
+
+    size_t reallocations() const
+    {
+      return reallocations_;
+    }
+
+    size_t bytesCopied() const
+    {
+      return bytesCopied_;
+    }
+
+  private:
+    char* data_;
+    size_t size_;
+    size_t capacity_;
+    size_t reallocations_;
+    size_t bytesCopied_;
+    size_t initial_;
+  };
+}
+
+#endif
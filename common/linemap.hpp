@@ -0,0 +1,156 @@
+#ifndef LINEMAP_HPP
+#define LINEMAP_HPP
+
+// Read-only view of a whole input file for the string labs. On POSIX
+// systems the file is mapped with mmap(), so lines reach the transforms as
+// (begin, len) spans pointing straight into the page cache without a copy.
+// On Windows the file is read into a malloc'ed buffer instead.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace linemap
+{
+  struct span_t
+  {
+    const char* begin;
+    size_t len;
+  };
+
+  class File
+  {
+  public:
+    File():
+      data_(nullptr),
+      size_(0)
+    {}
+
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    ~File()
+    {
+      reset();
+    }
+
+    // Maps the file at path in place of the current one. Returns false if
+    // it cannot be opened, inspected or mapped.
+    bool open(const char* path)
+    {
+      reset();
+#ifdef _WIN32
+      std::ifstream in(path, std::ios::binary);
+      if (!in.seekg(0, std::ios::end))
+      {
+        return false;
+      }
+      std::streamoff end = in.tellg();
+      if (end < 0 || !in.seekg(0))
+      {
+        return false;
+      }
+      size_t size = static_cast< size_t >(end);
+      char* data = static_cast< char* >(std::malloc(size + 1));
+      if (!data)
+      {
+        return false;
+      }
+      if (!in.read(data, size))
+      {
+        std::free(data);
+        return false;
+      }
+      data_ = data;
+      size_ = size;
+      return true;
+#else
+      int fd = ::open(path, O_RDONLY);
+      if (fd < 0)
+      {
+        return false;
+      }
+      struct stat info;
+      if (::fstat(fd, &info) != 0)
+      {
+        ::close(fd);
+        return false;
+      }
+      size_t size = static_cast< size_t >(info.st_size);
+      if (size != 0)
+      {
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+          ::close(fd);
+          return false;
+        }
+        ::madvise(data, size, MADV_SEQUENTIAL);
+        data_ = static_cast< const char* >(data);
+      }
+      ::close(fd);
+      size_ = size;
+      return true;
+#endif
+    }
+
+    const char* begin() const
+    {
+      return data_;
+    }
+
+    const char* end() const
+    {
+      return data_ + size_;
+    }
+
+    size_t size() const
+    {
+      return size_;
+    }
+
+  private:
+    const char* data_;
+    size_t size_;
+
+    void reset()
+    {
+      if (data_)
+      {
+#ifdef _WIN32
+        std::free(const_cast< char* >(data_));
+#else
+        ::munmap(const_cast< char* >(data_), size_);
+#endif
+      }
+      data_ = nullptr;
+      size_ = 0;
+    }
+  };
+
+  // Moves line to the line starting at pos and pos past it. The span does
+  // not include the newline; a line ends without one only at end. Returns
+  // false once pos has reached end.
+  inline bool nextLine(const char*& pos, const char* end, span_t& line)
+  {
+    if (pos == end)
+    {
+      return false;
+    }
+    const char* newline = static_cast< const char* >(std::memchr(pos, '\n', end - pos));
+    line.begin = pos;
+    line.len = (newline ? newline : end) - pos;
+    pos = newline ? newline + 1 : end;
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef LINEREAD_HPP
+#define LINEREAD_HPP
+
+// Line input in blocks for the string labs. readBlock() pulls up to a
+// block of the current line with istream::getline, which scans the stream
+// buffer for the delimiter with memchr instead of going through
+// operator>> once per character. getline() builds on it and collects the
+// line in a growbuf::Buffer that doubles through realloc, so reading a
+// line is linear in its length and growth can happen in place.
+
+#include <cstddef>
+#include <istream>
+#include <growbuf.hpp>
+
+namespace lineread
+{
+  enum class Block
+  {
+    more,
+    last,
+    failed
+  };
+
+  // Reads at most size bytes of the current line into block, which must
+  // have room for size + 1. got receives the number of bytes stored, not
+  // counting the delimiter. Returns Block::more if the line goes on past
+  // the block, Block::last if it ended on the delimiter or at end of input
+  // (in.eof() tells which) and Block::failed if the stream went bad.
+  inline Block readBlock(std::istream& in, char* block, size_t size, size_t& got, char delim = '\n')
+  {
+    in.getline(block, size + 1, delim);
+    got = in.gcount();
+    if (in.eof())
+    {
+      return Block::last;
+    }
+    if (!in.fail())
+    {
+      got--;
+      return Block::last;
+    }
+    if (got == size)
+    {
+      in.clear(in.rdstate() & ~std::ios_base::failbit);
+      return Block::more;
+    }
+    return Block::failed;
+  }
+
+  // Reads the rest of the current line into a NUL-terminated buffer from
+  // malloc() without the delimiter; len receives its length. Returns
+  // nullptr if memory runs out or the stream went bad (in.bad() tells
+  // which). The caller releases the line with free().
+  inline char* getline(std::istream& in, size_t& len, char delim = '\n')
+  {
+    const size_t initialCapacity = 65;
+    growbuf::Buffer< growbuf::Geometric< 2, 1 > > line(initialCapacity);
+    if (!line.reserve(initialCapacity))
+    {
+      return nullptr;
+    }
+
+    while (true)
+    {
+      size_t got = 0;
+      size_t room = line.capacity() - line.size() - 1;
+      Block block = readBlock(in, line.data() + line.size(), room, got, delim);
+      line.resize(line.size() + got);
+      if (block == Block::last)
+      {
+        break;
+      }
+      if (block == Block::failed || !line.reserve(line.capacity() + 1))
+      {
+        return nullptr;
+      }
+    }
+    len = line.size();
+    return line.release();
+  }
+}
+
+#endif
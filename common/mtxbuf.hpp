@@ -0,0 +1,184 @@
+#ifndef MTXBUF_HPP
+#define MTXBUF_HPP
+
+// Heap storage for the P3 matrices with a run-time allocation policy,
+// taken from the LAB_MTX_ALLOC environment variable:
+//   malloc      plain malloc (the default when the variable is unset);
+//   huge        anonymous mmap() backed by huge pages: MAP_HUGETLB when the
+//               kernel has a reserved pool, otherwise MADV_HUGEPAGE so that
+//               transparent huge pages back the buffer;
+//   huge-touch  as huge, and the pages are faulted in up front by several
+//               threads, each touching its own band of whole huge pages.
+// Whenever huge pages cannot be had the buffer quietly falls back to
+// malloc, and on Windows every policy is plain malloc.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#ifndef _WIN32
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#endif
+
+namespace mtxbuf
+{
+  enum class Policy
+  {
+    plain,
+    huge,
+    hugeTouch
+  };
+
+  // Reads the policy from LAB_MTX_ALLOC. Returns false for an unknown name.
+  inline bool policyFromEnv(Policy& policy)
+  {
+    const char* name = std::getenv("LAB_MTX_ALLOC");
+    if (!name || !*name || std::strcmp(name, "malloc") == 0)
+    {
+      policy = Policy::plain;
+    }
+    else if (std::strcmp(name, "huge") == 0)
+    {
+      policy = Policy::huge;
+    }
+    else if (std::strcmp(name, "huge-touch") == 0)
+    {
+      policy = Policy::hugeTouch;
+    }
+    else
+    {
+      return false;
+    }
+    return true;
+  }
+
+  namespace detail
+  {
+    constexpr size_t hugePage = size_t(2) << 20;
+    constexpr size_t maxTouchThreads = 8;
+
+    inline void touch(char* begin, char* end)
+    {
+      for (char* page = begin; page < end; page += 4096)
+      {
+        *page = 0;
+      }
+    }
+
+#ifndef _WIN32
+    inline void touchParallel(char* data, size_t size)
+    {
+      size_t bands = size / hugePage;
+      size_t threads = std::thread::hardware_concurrency();
+      threads = threads < bands ? threads : bands;
+      threads = threads < maxTouchThreads ? threads : maxTouchThreads;
+      if (threads < 2)
+      {
+        touch(data, data + size);
+        return;
+      }
+
+      size_t perThread = (bands + threads - 1) / threads * hugePage;
+      std::vector< std::thread > workers;
+      char* next = data;
+      try
+      {
+        for (size_t t = 1; t < threads && next + perThread < data + size; t++)
+        {
+          workers.emplace_back(touch, next, next + perThread);
+          next += perThread;
+        }
+      }
+      catch (const std::system_error&)
+      {}
+      touch(next, data + size);
+      for (std::thread& worker: workers)
+      {
+        worker.join();
+      }
+    }
+#endif
+  }
+
+  class Buffer
+  {
+  public:
+    explicit Buffer(Policy policy):
+      policy_(policy),
+      data_(nullptr),
+      mapped_(0)
+    {}
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    ~Buffer()
+    {
+      reset();
+    }
+
+    // Replaces the current storage with room for count ints. Returns
+    // nullptr if even the malloc fallback fails.
+    int* allocate(size_t count)
+    {
+      reset();
+      size_t size = (count ? count : 1) * sizeof(int);
+#ifndef _WIN32
+      if (policy_ != Policy::plain)
+      {
+        size_t rounded = (size + detail::hugePage - 1) / detail::hugePage * detail::hugePage;
+        void* data = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        data = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+        if (data == MAP_FAILED)
+        {
+          data = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+          if (data != MAP_FAILED)
+          {
+            ::madvise(data, rounded, MADV_HUGEPAGE);
+          }
+#endif
+        }
+        if (data != MAP_FAILED)
+        {
+          data_ = static_cast< int* >(data);
+          mapped_ = rounded;
+          if (policy_ == Policy::hugeTouch)
+          {
+            detail::touchParallel(static_cast< char* >(data), rounded);
+          }
+          return data_;
+        }
+      }
+#endif
+      data_ = static_cast< int* >(std::malloc(size));
+      return data_;
+    }
+
+  private:
+    Policy policy_;
+    int* data_;
+    size_t mapped_;
+
+    void reset()
+    {
+#ifndef _WIN32
+      if (mapped_)
+      {
+        ::munmap(data_, mapped_);
+        data_ = nullptr;
+        mapped_ = 0;
+        return;
+      }
+#endif
+      std::free(data_);
+      data_ = nullptr;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef PROBE_HPP
+#define PROBE_HPP
+
+// Scoped timers and named counters for lab hot paths.
+// Built with -DLAB_PROBE (make PROBE=yes) they are collected and, if the
+// LAB_PROBE_REPORT environment variable is set, printed to stderr at exit.
+// Without LAB_PROBE every macro expands to nothing. The registry is not
+// synchronised: use the macros from the main thread only.
+
+#ifdef LAB_PROBE
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace probe
+{
+  struct entry_t
+  {
+    const char* name;
+    bool isTimer;
+    unsigned long long hits;
+    unsigned long long value;
+  };
+
+  class Registry
+  {
+  public:
+    static const size_t capacity = 64;
+
+    ~Registry()
+    {
+      if (!std::getenv("LAB_PROBE_REPORT"))
+      {
+        return;
+      }
+      for (size_t i = 0; i < size_; i++)
+      {
+        const entry_t& e = entries_[i];
+        if (e.isTimer)
+        {
+          std::fprintf(stderr, "[probe] %-24s %12llu calls %16llu ns\n", e.name, e.hits, e.value);
+        }
+        else
+        {
+          std::fprintf(stderr, "[probe] %-24s %12llu hits  %16llu\n", e.name, e.hits, e.value);
+        }
+      }
+    }
+
+    entry_t& get(const char* name, bool isTimer)
+    {
+      for (size_t i = 0; i < size_; i++)
+      {
+        if (std::strcmp(entries_[i].name, name) == 0)
+        {
+          return entries_[i];
+        }
+      }
+      if (size_ == capacity)
+      {
+        return overflow_;
+      }
+      entries_[size_] = {name, isTimer, 0, 0};
+      return entries_[size_++];
+    }
+
+  private:
+    entry_t entries_[capacity] = {};
+    entry_t overflow_ = {"<overflow>", false, 0, 0};
+    size_t size_ = 0;
+  };
+
+  inline entry_t& entry(const char* name, bool isTimer)
+  {
+    static Registry registry;
+    return registry.get(name, isTimer);
+  }
+
+  class ScopedTimer
+  {
+  public:
+    explicit ScopedTimer(entry_t& e):
+      entry_(e),
+      start_(std::chrono::steady_clock::now())
+    {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer()
+    {
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      entry_.hits++;
+      entry_.value += std::chrono::duration_cast< std::chrono::nanoseconds >(elapsed).count();
+    }
+
+  private:
+    entry_t& entry_;
+    std::chrono::steady_clock::time_point start_;
+  };
+}
+
+#define PROBE_CONCAT_IMPL(a, b) a##b
+#define PROBE_CONCAT(a, b) PROBE_CONCAT_IMPL(a, b)
+
+#define PROBE_SCOPE(name) \
+  static probe::entry_t& PROBE_CONCAT(probeEntry, __LINE__) = probe::entry(name, true); \
+  probe::ScopedTimer PROBE_CONCAT(probeTimer, __LINE__)(PROBE_CONCAT(probeEntry, __LINE__))
+
+#define PROBE_COUNT(name, n) \
+  do \
+  { \
+    static probe::entry_t& probeEntry = probe::entry(name, false); \
+    probeEntry.hits++; \
+    probeEntry.value += (n); \
+  } \
+  while (false)
+
+#else
+
+#define PROBE_SCOPE(name) static_cast< void >(0)
+#define PROBE_COUNT(name, n) static_cast< void >(sizeof(n))
+
+#endif
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef SMALLSTR_HPP
+#define SMALLSTR_HPP
+
+// NUL-terminated byte string with inline storage for short contents.
+// Strings up to Inline - 1 bytes never touch the heap; longer ones spill
+// to a malloc'ed block that grows geometrically. data()/size() plug into
+// the char*-based transforms. Growth reports failure by returning false.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+namespace smallstr
+{
+  template< size_t Inline = 64 >
+  class String
+  {
+    static_assert(Inline > 1, "inline storage must fit at least one byte");
+
+  public:
+    String():
+      data_(inline_),
+      size_(0),
+      capacity_(Inline - 1)
+    {
+      inline_[0] = '\0';
+    }
+
+    String(String&& other) noexcept:
+      data_(inline_),
+      size_(other.size_),
+      capacity_(Inline - 1)
+    {
+      if (other.onHeap())
+      {
+        data_ = other.data_;
+        capacity_ = other.capacity_;
+        other.data_ = other.inline_;
+        other.capacity_ = Inline - 1;
+      }
+      else
+      {
+        std::memcpy(inline_, other.inline_, size_ + 1);
+      }
+      other.size_ = 0;
+      other.inline_[0] = '\0';
+    }
+
+    String(const String&) = delete;
+    String& operator=(const String&) = delete;
+    String& operator=(String&&) = delete;
+
+    ~String()
+    {
+      if (onHeap())
+      {
+        std::free(data_);
+      }
+    }
+
+    bool reserve(size_t capacity)
+    {
+      if (capacity <= capacity_)
+      {
+        return true;
+      }
+      size_t grown = capacity_ * 2;
+      capacity = capacity < grown ? grown : capacity;
+      char* block = static_cast< char* >(std::realloc(onHeap() ? data_ : nullptr, capacity + 1));
+      if (!block)
+      {
+        return false;
+      }
+      if (!onHeap())
+      {
+        std::memcpy(block, inline_, size_ + 1);
+      }
+      data_ = block;
+      capacity_ = capacity;
+      return true;
+    }
+
+    // Sets the length to size and terminates the string there; bytes
+    // between the old and the new length are left as they are.
+    bool resize(size_t size)
+    {
+      if (!reserve(size))
+      {
+        return false;
+      }
+      size_ = size;
+      data_[size_] = '\0';
+      return true;
+    }
+
+    bool push_back(char c)
+    {
+      if (size_ == capacity_ && !reserve(size_ + 1))
+      {
+        return false;
+      }
+      data_[size_++] = c;
+      data_[size_] = '\0';
+      return true;
+    }
+
+    void clear()
+    {
+      size_ = 0;
+      data_[0] = '\0';
+    }
+
+    char* data()
+    {
+      return data_;
+    }
+
+    const char* data() const
+    {
+      return data_;
+    }
+
+    const char* c_str() const
+    {
+      return data_;
+    }
+
+    size_t size() const
+    {
+      return size_;
+    }
+
+    size_t capacity() const
+    {
+      return capacity_;
+    }
+
+    bool onHeap() const
+    {
+      return data_ != inline_;
+    }
+
+  private:
+    char* data_;
+    size_t size_;
+    size_t capacity_;
+    char inline_[Inline];
+  };
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+// UTF-8 helpers for the letter operations. asciiPrefix() skips pure-ASCII
+// input eight bytes at a time, so callers run their single-byte fast path
+// on those spans and decode only the remaining multi-byte sequences.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace utf8
+{
+  inline size_t asciiPrefix(const char* str, size_t len)
+  {
+    const std::uint64_t highBits = 0x8080808080808080ull;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+      std::uint64_t word = 0;
+      std::memcpy(&word, str + i, 8);
+      if (word & highBits)
+      {
+        break;
+      }
+    }
+    while (i < len && static_cast< unsigned char >(str[i]) < 0x80)
+    {
+      i++;
+    }
+    return i;
+  }
+
+  // Decodes the sequence at the start of str. Returns its length in bytes,
+  // or 0 if it is truncated, overlong, a surrogate or beyond U+10FFFF.
+  inline size_t decode(const char* str, size_t len, unsigned long& codePoint)
+  {
+    if (len == 0)
+    {
+      return 0;
+    }
+    unsigned char lead = static_cast< unsigned char >(str[0]);
+    size_t size = 0;
+    unsigned long minimum = 0;
+    if (lead < 0x80)
+    {
+      codePoint = lead;
+      return 1;
+    }
+    else if ((lead & 0xE0) == 0xC0)
+    {
+      size = 2;
+      minimum = 0x80;
+      codePoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+      size = 3;
+      minimum = 0x800;
+      codePoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+      size = 4;
+      minimum = 0x10000;
+      codePoint = lead & 0x07;
+    }
+    else
+    {
+      return 0;
+    }
+    if (len < size)
+    {
+      return 0;
+    }
+    for (size_t i = 1; i < size; i++)
+    {
+      unsigned char next = static_cast< unsigned char >(str[i]);
+      if ((next & 0xC0) != 0x80)
+      {
+        return 0;
+      }
+      codePoint = (codePoint << 6) | (next & 0x3F);
+    }
+    bool surrogate = codePoint >= 0xD800 && codePoint <= 0xDFFF;
+    if (codePoint < minimum || surrogate || codePoint > 0x10FFFF)
+    {
+      return 0;
+    }
+    return size;
+  }
+
+  inline bool isValid(const char* str, size_t len)
+  {
+    size_t i = 0;
+    while (i < len)
+    {
+      i += asciiPrefix(str + i, len - i);
+      if (i == len)
+      {
+        break;
+      }
+      unsigned long codePoint = 0;
+      size_t size = decode(str + i, len - i, codePoint);
+      if (size == 0)
+      {
+        return false;
+      }
+      i += size;
+    }
+    return true;
+  }
+
+  // Index of a Russian letter in the alphabet order without case
+  // (0 for "а", 6 for "ё", 32 for "я"), or -1 for any other code point.
+  inline int cyrillicIndex(unsigned long codePoint)
+  {
+    if (codePoint == 0x401 || codePoint == 0x451)
+    {
+      return 6;
+    }
+    if (codePoint >= 0x410 && codePoint <= 0x44F)
+    {
+      int index = static_cast< int >((codePoint - 0x410) & 0x1F);
+      return index < 6 ? index : index + 1;
+    }
+    return -1;
+  }
+}
+
+#endif
@@ -1,9 +0,0 @@
-#ifndef EXTEND_SIZE
-#define EXTEND_SIZE
-#include <cstddef>
-
-namespace dirko
-{
-  char *extendSize(const char *str, size_t size);
-}
-#endif
@@ -1,17 +1,19 @@
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
-#include "getLine.hpp"
+#include <lineread.hpp>
 #include "strActions.hpp"
 
-int main()
+int main(int argc, char *argv[])
 {
+  bool cyrillic = argc > 1 && std::strcmp(argv[1], "--cyrillic") == 0;
   size_t size = 0;
-  char *str = dirko::getLine(std::cin, size);
+  char *str = lineread::getline(std::cin, size);
   if (str == nullptr) {
     std::cerr << "Cant alloc\n";
     return 1;
   }
-  if (std::cin.fail()) {
+  if (std::cin.eof()) {
     free(str);
     std::cerr << "Cant read\n";
     return 1;
@@ -21,17 +23,9 @@ int main()
     std::cerr << "Empty string\n";
     return 1;
   }
-  size_t result1 = dirko::doDifLat(str);
-  char *result2 = reinterpret_cast< char * >(malloc(sizeof(char) * (size + 1)));
-  if (result2 == nullptr) {
-    free(str);
-    std::cerr << "Cant alloc\n";
-    return 1;
-  }
-  result2[size] = '\0';
-  dirko::doUppLow(str, result2);
+  size_t result1 = dirko::doDifLetUtf8(str, std::strlen(str), cyrillic);
+  dirko::doUppLow(str, str);
   std::cout << result1 << '\n';
-  std::cout << result2 << '\n';
+  std::cout << str << '\n';
   free(str);
-  free(result2);
 }
@@ -1,32 +1,40 @@
 #include "strActions.hpp"
-#include <cctype>
+#include <bitset>
+#include <cstring>
+#include <ascii.hpp>
+#include <utf8.hpp>
 
-const char *dirko::find(const char *start, const char *end, char target)
+unsigned long long dirko::getLetterMaskUtf8(const char *str, size_t len, bool cyrillic)
 {
-  for (const char *ch = start; ch < end; ++ch) {
-    if (*ch == target) {
-      return ch;
+  if (!cyrillic) {
+    return ascii::latinMask(str, len);
+  }
+  const unsigned long long allLetters = (1ull << (alphaSize + cyrAlphaSize)) - 1;
+  unsigned long long mask = 0;
+  size_t i = 0;
+  while (i < len && mask != allLetters) {
+    size_t asciiLen = utf8::asciiPrefix(str + i, len - i);
+    mask |= ascii::latinMask(str + i, asciiLen);
+    i += asciiLen;
+    if (i == len) {
+      break;
+    }
+    unsigned long codePoint = 0;
+    size_t size = utf8::decode(str + i, len - i, codePoint);
+    int index = utf8::cyrillicIndex(codePoint);
+    if (size != 0 && index >= 0) {
+      mask |= (1ull << alphaSize) << index;
     }
+    i += size == 0 ? 1 : size;
   }
-  return end;
+  return mask;
 }
-size_t dirko::doDifLat(const char *str)
+size_t dirko::doDifLetUtf8(const char *str, size_t len, bool cyrillic)
 {
-  size_t count = 0;
-  char seen[alphaSize] = {};
-  for (const char *ch = str; *ch != '\0'; ++ch) {
-    if (std::isalpha(*ch)) {
-      if (dirko::find(seen, seen + count, std::tolower(*ch)) == seen + count) {
-        seen[count++] = std::tolower(*ch);
-      }
-    }
-  }
-  return count;
+  return std::bitset< alphaSize + cyrAlphaSize >(getLetterMaskUtf8(str, len, cyrillic)).count();
 }
 char *dirko::doUppLow(const char *source, char *distention)
 {
-  for (size_t i = 0; source[i] != '\0'; ++i) {
-    distention[i] = (std::isalpha(source[i])) ? std::tolower(source[i]) : source[i];
-  }
+  ascii::toLower(source, std::strlen(source), distention);
   return distention;
 }
@@ -5,8 +5,9 @@
 namespace dirko
 {
   const size_t alphaSize = 26;
-  const char *find(const char *start, const char *end, char target);
-  size_t doDifLat(const char *str);
+  const size_t cyrAlphaSize = 33;
+  unsigned long long getLetterMaskUtf8(const char *str, size_t len, bool cyrillic);
+  size_t doDifLetUtf8(const char *str, size_t len, bool cyrillic);
   char *doUppLow(const char *source, char *distention);
 }
 #endif
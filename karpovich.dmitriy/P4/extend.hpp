@@ -1,8 +0,0 @@
-#ifndef EXTEND_HPP
-#define EXTEND_HPP
-#include <iosfwd>
-namespace karpovich
-{
-  char* extend(char* old_str, size_t old_size);
-}
-#endif
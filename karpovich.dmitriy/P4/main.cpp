@@ -1,14 +1,14 @@
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
-#include "getline.hpp"
-#include "extend.hpp"
+#include <lineread.hpp>
 #include "strChange.hpp"
 
 int main() {
   namespace karp = karpovich;
 
   size_t s = 0;
-  char* str = karp::getline(std::cin, s);
+  char* str = lineread::getline(std::cin, s);
   if (!str) {
     std::cerr << "Failed to alloc memory" << '\n';
     return 1;
@@ -26,12 +26,6 @@ int main() {
     return 1;
   }
   data[s] = '\0';
-  if (!karp::repsym(str, data)) {
-    free(data);
-    free(str);
-    std::cerr << "repsym failed" << '\n';
-    return 1;
-  }
 
   size_t s2 = 4;
   const char* str2 = "def ";
@@ -45,11 +39,11 @@ int main() {
   }
   data2[s + s2] = '\0';
 
-  if (!karp::unitwo(str, str2, s, s2, data2)) {
+  if (!karp::repsymUnitwo(str, str2, s, s2, data, data2)) {
     free(data2);
     free(data);
     free(str);
-    std::cerr << "unitwo failed" << '\n';
+    std::cerr << "repsym failed" << '\n';
     return 1;
   }
 
@@ -1,46 +1,42 @@
 #include "strChange.hpp"
 #include <iostream>
-char* karpovich::repsym(const char* str, char* data)
+#include <cstring>
+char* karpovich::repsymUnitwo(const char* str1, const char* str2, size_t s1, size_t s2, char* data, char* data2)
 {
   constexpr size_t MAX_ascii = 256;
-  if (!str || !data) {
+  if (!str1 || !str2 || !data || !data2) {
     return nullptr;
   }
 
+  const char* nul = reinterpret_cast< const char* >(std::memchr(str1, '\0', s1));
+  size_t counted = nul ? nul - str1 : s1;
+
   int repeat[MAX_ascii] = {};
-  for (size_t i = 0; str[i] != '\0'; ++i) {
-    unsigned char c = static_cast< unsigned char >(str[i]);
-    ++repeat[c];
+  unsigned char order[MAX_ascii + 1] = {};
+  size_t distinct = 0;
+  size_t k = 0;
+  for (size_t i = 0; i < s1; ++i) {
+    unsigned char c = static_cast< unsigned char >(str1[i]);
+    bool first = repeat[c] == 0 && i < counted;
+    repeat[c] += i < counted;
+    order[distinct] = c;
+    distinct += first;
+    data2[k++] = str1[i];
+    if (i < s2) {
+      data2[k++] = str2[i];
+    }
+  }
+  for (size_t j = s1; j < s2; ++j) {
+    data2[k++] = str2[j];
   }
+  data2[k] = '\0';
 
-  int saw[MAX_ascii] = {};
   size_t pos = 0;
-  for (size_t i = 0; str[i] != '\0'; ++i) {
-    unsigned char c = static_cast< unsigned char >(str[i]);
-    if (repeat[c] > 1 && saw[c] == '\0') {
-      data[pos++] = c;
-      saw[c] = 1;
+  for (size_t i = 0; i < distinct; ++i) {
+    if (repeat[order[i]] > 1) {
+      data[pos++] = order[i];
     }
   }
   data[pos] = '\0';
-  return data;
-}
-char* karpovich::unitwo(const char* str1, const char* str2, size_t s1, size_t s2, char* data)
-{
-  if (!str1 || !str2 || !data) {
-    return nullptr;
-  }
-  size_t i = 0, j = 0, k = 0;
-  while (i < s1 && j < s2) {
-    data[k++] = str1[i++];
-    data[k++] = str2[j++];
-  }
-  while (i < s1) {
-    data[k++] = str1[i++];
-  }
-  while (j < s2) {
-    data[k++] = str2[j++];
-  }
-  data[k] = '\0';
-  return data;
+  return data2;
 }
@@ -3,7 +3,6 @@
 #include <iosfwd>
 namespace karpovich
 {
-  char* repsym(const char* str, char* data);
-  char* unitwo(const char* str1, const char* str2, size_t s1, size_t s2, char* data);
+  char* repsymUnitwo(const char* str1, const char* str2, size_t s1, size_t s2, char* data, char* data2);
 }
 #endif
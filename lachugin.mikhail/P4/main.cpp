@@ -1,49 +1,15 @@
 #include <iostream>
+#include <cstdlib>
+#include <charset.hpp>
+#include <lineread.hpp>
 
 namespace lachugin
 {
-  const size_t startSize = 10;
   bool hasSam(const char* frsLine, const char* scnLine)
   {
-    for (size_t i = 0; frsLine[i] != '\0'; i++)
-    {
-      if (frsLine[i] == ' ')
-      {
-        continue;
-      }
-      for (size_t j = 0; scnLine[j] != '\0'; j++)
-      {
-        if (frsLine[i] == scnLine[j])
-        {
-          return true;
-        }
-      }
-    }
-    return false;
-  }
-
-  void fopy(const char* oldLine, size_t s, char* newLine)
-  {
-    for (size_t i = 0; i < s; i++)
-    {
-      newLine[i] = oldLine[i];
-    }
-  }
-
-  char* cut(const char* str, size_t& s)
-  {
-    char* newLine = reinterpret_cast< char* >(malloc((s + 1) * sizeof(char)));
-    if (!newLine)
-    {
-      return nullptr;
-    }
-
-    for (size_t i = 0; i < s; i++)
-    {
-      newLine[i] = str[i];
-    }
-    newLine[s] = '\0';
-    return newLine;
+    constexpr charset::table_t space = charset::fromLiteral(" ");
+    charset::table_t inScn = charset::subtract(charset::fromString(scnLine), space);
+    return !charset::isEmpty(charset::intersect(charset::fromString(frsLine), inScn));
   }
 
   char* latRmv(const char* str, char* newLine)
@@ -65,69 +31,22 @@ namespace lachugin
     return newLine;
   }
 
-  char* expand(const char* oldLine, size_t& oldSize)
-  {
-    size_t newSize = oldSize + startSize;
-    char* newLine = reinterpret_cast< char* >(malloc(newSize * sizeof(char)));
-    if (!newLine)
-    {
-      return nullptr;
-    }
-    fopy(oldLine, oldSize, newLine);
-    oldSize = newSize;
-    return newLine;
-  }
-
   char* getline(std::istream& in, size_t& s)
   {
-    size_t capacity = 10;
-    char* data = reinterpret_cast< char* >(malloc(capacity * sizeof(char)));
-    if (!data)
-    {
-      return nullptr;
-    }
-    bool is_skip = in.flags() & std::ios_base::skipws;
-    if (is_skip)
+    char* data = lineread::getline(in, s);
+    if (!data || in.eof())
     {
-      in >> std::noskipws;
+      return data;
     }
-
-    s = 0;
-    char hlpChar = ' ';
-    while (hlpChar != '\n')
-    {
-      if (s + 1 >= capacity)
-      {
-        char* helpLine = expand(data, capacity);
-        if (!helpLine)
-        {
-          if (is_skip)
-          {
-            in >> std::skipws;
-          }
-          free(data);
-          return nullptr;
-        }
-        free(data);
-        data = helpLine;
-      }
-      if (!(in >> hlpChar))
-      {
-        break;
-      }
-      data[s++] = hlpChar;
-    }
-    data[s] = '\0';
-    char* helpLine = cut(data, s);
-    free(data);
-    data = helpLine;
-
-    if (is_skip)
+    char* helpLine = reinterpret_cast< char* >(realloc(data, (s + 2) * sizeof(char)));
+    if (!helpLine)
     {
-      in >> std::skipws;
+      free(data);
+      return nullptr;
     }
-
-    return data;
+    helpLine[s++] = '\n';
+    helpLine[s] = '\0';
+    return helpLine;
   }
 }
 
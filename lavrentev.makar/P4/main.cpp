@@ -1,24 +1,21 @@
 #include <iostream>
+#include <cstdlib>
 #include <cstring>
 #include <ios>
 #include <new>
+#include <lineread.hpp>
 
 namespace lavrentev
 {
   size_t difLat(char* s1, char* buf1);
   void uniTwo(char* s1, char* s2, size_t ex, size_t ex2, char* result);
-  char* getline(std::istream& in, size_t& n);
 }
 
 int main()
 {
-  char* s1 = nullptr;
   size_t ex = 0;
-  try
-  {
-    s1 = lavrentev::getline(std::cin, ex);
-  }
-  catch (const std::bad_alloc&)
+  char* s1 = lineread::getline(std::cin, ex);
+  if (s1 == nullptr)
   {
     std::cerr << "Memory allocation fail" << '\n';
     return 1;
@@ -27,7 +24,7 @@ int main()
   if (ex == 0)
   {
     std::cerr << "Invalid string" << '\n';
-    delete[] s1;
+    std::free(s1);
     return 1;
   }
 
@@ -40,7 +37,7 @@ int main()
   catch (const std::bad_alloc&)
   {
     std::cerr << "Memory allocation fail" << '\n';
-    delete[] s1;
+    std::free(s1);
     return 1;
   }
 
@@ -57,7 +54,7 @@ int main()
   {
     std::cerr << "Memory allocation fail" << '\n';
     delete[] buf1;
-    delete[] s1;
+    std::free(s1);
     return 1;
   }
 
@@ -68,7 +65,7 @@ int main()
   std::cout << "Ans 12: " << result << '\n';
 
   delete[] buf1;
-  delete[] s1;
+  std::free(s1);
   delete[] result;
 }
 
@@ -138,80 +135,3 @@ void lavrentev::uniTwo(char* s1, char* s2, size_t ex, size_t ex2, char* result)
   }
   result[ex + ex2] = '\0';
 }
-
-char* lavrentev::getline(std::istream& in, size_t& n)
-{
-  size_t cap = 10;
-
-  bool is_skipws = in.flags() & std::ios_base::skipws;
-  if (is_skipws)
-  {
-    in >> std::noskipws;
-  }
-
-  char* s = nullptr;
-
-  try
-  {
-    s = new char[cap];
-  }
-  catch (const std::bad_alloc&)
-  {
-    n = 0;
-
-    if (is_skipws)
-    {
-      in >> std::skipws;
-    }
-
-    throw;
-  }
-
-  char st;
-  while (in >> st && st != '\n')
-  {
-    if (n == cap - 1)
-    {
-      size_t new_cap = cap + cap / 2;
-      char* new_s = nullptr;
-
-      try
-      {
-        new_s = new char[new_cap];
-      }
-      catch (const std::bad_alloc&)
-      {
-        delete[] s;
-        n = 0;
-
-        if (is_skipws)
-        {
-          in >> std::skipws;
-        }
-
-        throw;
-      }
-
-      for (size_t j = 0; j < n; ++j)
-      {
-        new_s[j] = s[j];
-      }
-
-      delete[] s;
-      s = new_s;
-      cap = new_cap;
-    }
-
-    s[n] = st;
-    ++n;
-  }
-
-  s[n] = '\0';
-
-  if (is_skipws)
-  {
-    in >> std::skipws;
-  }
-
-  return s;
-}
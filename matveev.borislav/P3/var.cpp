@@ -2,6 +2,7 @@
 #include <fstream>
 #include <cstdlib>
 #include <memory>
+#include <mtxbuf.hpp>
 
 namespace matveev
 {
@@ -27,6 +28,13 @@ int main(int argc, char * argv[])
     return 1;
   }
 
+  mtxbuf::Policy policy = mtxbuf::Policy::plain;
+  if (!mtxbuf::policyFromEnv(policy))
+  {
+    std::cerr << "Error unknown LAB_MTX_ALLOC policy\n";
+    return 1;
+  }
+
   const char * in  = argv[2];
   const char * out = argv[3];
 
@@ -53,7 +61,7 @@ int main(int argc, char * argv[])
   const size_t max_cols = 100;
   int * matrix = nullptr;
   int fixed_matrix[max_rows * max_cols] = {0};
-  bool isDynamic = false;
+  mtxbuf::Buffer heap_matrix(policy);
 
   if (num == 1)
   {
@@ -63,16 +71,11 @@ int main(int argc, char * argv[])
       return 1;
     }
     matrix = fixed_matrix;
-    isDynamic = false;
   }
   else if (num == 2)
   {
-    try
-    {
-      matrix = new int[rows * cols];
-      isDynamic = true;
-    }
-    catch (const std::bad_alloc &)
+    matrix = heap_matrix.allocate(rows * cols);
+    if (matrix == nullptr)
     {
       std::cerr << "Error memory allocation failed\n";
       return 1;
@@ -82,34 +85,31 @@ int main(int argc, char * argv[])
   if (!matveev::rMatrix(file, matrix, rows, cols))
   {
     std::cerr << "Error not enough data\n";
-    if (isDynamic)
-    {
-      delete[] matrix;
-    }
     return 1;
   }
 
   matveev::spiral(matrix, rows, cols);
-  size_t MaxSeq = matveev::find(matrix, rows, cols);
+  size_t MaxSeq = 0;
+  try
+  {
+    MaxSeq = matveev::find(matrix, rows, cols);
+  }
+  catch (const std::bad_alloc &)
+  {
+    std::cerr << "Error memory allocation failed\n";
+    return 1;
+  }
 
   std::ofstream oFile(out);
   if (!oFile.is_open())
   {
     std::cerr << "Error cannot open output file\n";
-    if (isDynamic)
-    {
-      delete[] matrix;
-    }
     return 1;
   }
 
   matveev::wMatrix(oFile, matrix, rows, cols);
   oFile << '\n' << MaxSeq << '\n';
 
-  if (isDynamic)
-  {
-    delete[] matrix;
-  }
   return 0;
 }
 
@@ -214,33 +214,45 @@ size_t matveev::find(const int * matrix, size_t rows, size_t cols)
     return 0;
   }
 
-  size_t maxLen = 0;
-  size_t res = 0;
-
+  size_t * ser = new size_t[cols * 2];
+  size_t * best = ser + cols;
   for (size_t col = 0; col < cols; ++col)
   {
-    size_t ser = 1;
-    for (size_t row = 1; row < rows; ++row)
+    ser[col] = 1;
+    best[col] = 1;
+  }
+
+  for (size_t row = 1; row < rows; ++row)
+  {
+    const int * cur = matrix + row * cols;
+    const int * prev = cur - cols;
+    for (size_t col = 0; col < cols; ++col)
     {
-      if (matrix[row * cols + col] == matrix[(row - 1) * cols + col])
+      if (cur[col] == prev[col])
       {
-        ser++;
+        ser[col]++;
+        if (ser[col] > best[col])
+        {
+          best[col] = ser[col];
+        }
       }
       else
       {
-        if (ser > maxLen)
-        {
-          maxLen = ser;
-          res = col;
-        }
-        ser = 1;
+        ser[col] = 1;
       }
     }
-    if (ser > maxLen)
+  }
+
+  size_t maxLen = 0;
+  size_t res = 0;
+  for (size_t col = 0; col < cols; ++col)
+  {
+    if (best[col] > maxLen)
     {
-      maxLen = ser;
+      maxLen = best[col];
       res = col;
     }
   }
+  delete[] ser;
   return res;
 }
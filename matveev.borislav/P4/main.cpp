@@ -1,11 +1,12 @@
 #include <iostream>
 #include <cstdlib>
-#include <cctype>
 #include <cstring>
+#include <ascii.hpp>
+#include <charset.hpp>
+#include <lineread.hpp>
 
 namespace matveev
 {
-  char* getLine(std::istream& in, size_t& len);
   char* rmLat(char* dest, const char* src);
   int hasRep(const char* str);
 }
@@ -13,9 +14,10 @@ namespace matveev
 int main()
 {
   size_t len = 0;
-  char* str = matveev::getLine(std::cin, len);
-  if (str == nullptr)
+  char* str = lineread::getline(std::cin, len);
+  if (str == nullptr || (len == 0 && std::cin.eof()))
   {
+    std::free(str);
     std::cerr << "Error memory\n";
     return 1;
   }
@@ -36,73 +38,13 @@ int main()
   return 0;
 }
 
-char* matveev::getLine(std::istream& in, size_t& len)
-{
-  size_t cap = 16;
-  len = 0;
-  char* buf = reinterpret_cast< char* >(std::malloc(cap));
-  if (buf == nullptr)
-  {
-    return nullptr;
-  }
-  bool wasSkip = (in.flags() & std::ios_base::skipws);
-  if (wasSkip)
-  {
-    in >> std::noskipws;
-  }
-  char c = '\0';
-  bool read = false;
-  while (in >> c && c != '\n')
-  {
-    read = true;
-    if (len + 1 >= cap)
-    {
-      size_t newCap = cap * 2;
-      char* newBuf = reinterpret_cast< char* >(std::malloc(newCap));
-      if (newBuf == nullptr)
-      {
-        std::free(buf);
-        if (wasSkip)
-        {
-          in >> std::skipws;
-        }
-        return nullptr;
-      }
-      std::memcpy(newBuf, buf, cap);
-      std::free(buf);
-      buf = newBuf;
-      cap = newCap;
-    }
-    buf[len] = c;
-    len++;
-  }
-  if (!read && (in.eof() || in.fail()))
-  {
-    std::free(buf);
-    if (wasSkip)
-    {
-      in >> std::skipws;
-    }
-    return nullptr;
-  }
-  buf[len] = '\0';
-  if (wasSkip)
-  {
-    in >> std::skipws;
-  }
-  return buf;
-}
-
 char* matveev::rmLat(char* dest, const char* src)
 {
   size_t j = 0;
   for (size_t i = 0; src[i] != '\0'; ++i)
   {
-    if (!std::isalpha(static_cast< unsigned char >(src[i])))
-    {
-      dest[j] = src[i];
-      j++;
-    }
+    dest[j] = src[i];
+    j += !ascii::isLatin(src[i]);
   }
   dest[j] = '\0';
   return dest;
@@ -110,15 +52,15 @@ char* matveev::rmLat(char* dest, const char* src)
 
 int matveev::hasRep(const char* str)
 {
+  charset::table_t seen = {};
   for (size_t i = 0; str[i] != '\0'; ++i)
   {
-    for (size_t j = i + 1; str[j] != '\0'; ++j)
+    unsigned char& mark = seen.bits[static_cast< unsigned char >(str[i])];
+    if (mark)
     {
-      if (str[i] == str[j])
-      {
-        return 1;
-      }
+      return 1;
     }
+    mark = 1;
   }
   return 0;
 }
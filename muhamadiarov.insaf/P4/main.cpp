@@ -1,75 +1,12 @@
 #include <iostream>
 #include <iomanip>
 #include <cctype>
+#include <cstdlib>
+#include <charset.hpp>
+#include <lineread.hpp>
 
 namespace muhamadiarov
 {
-  bool checkOnRepeat(const char *line, char symbol, size_t size)
-  {
-    for (size_t i = 0; i < size; ++i)
-    {
-      if (line[i] == symbol)
-      {
-        return true;
-      }
-    }
-    return false;
-  }
-  char *getline(std::istream &in, size_t &size)
-  {
-    bool is_skipws = in.flags() & std::ios_base::skipws;
-    if (is_skipws)
-    {
-      in >> std::noskipws;
-    }
-    const size_t beginSize = 20;
-    char *str = new char[beginSize];
-    size_t comp = beginSize;
-    char ch = ' ';
-    while (in >> ch && ch != '\n')
-    {
-      try
-      {
-        if (size == comp - 1)
-        {
-          char *tmp = new char[comp * 2];
-          comp *= 2;
-          for (size_t i = 0; i < size; ++i)
-          {
-            tmp[i] = str[i];
-          }
-          delete[] str;
-          str = tmp;
-        }
-      }
-      catch (const std::bad_alloc&)
-      {
-        if (is_skipws)
-        {
-          in >> std::skipws;
-        }
-        delete[] str;
-        throw;
-      }
-      str[size] = ch;
-      ++size;
-    }
-    if (in.fail())
-    {
-      if (is_skipws)
-      {
-        in >> std::skipws;
-      }
-      delete[] str;
-      throw std::logic_error("Error input");
-    }
-    str[size] = '\0';
-    if (is_skipws)
-    {
-      in >> std::skipws;
-    }
-    return str;
-  }
   char *latRmv(char *res, const char *str)
   {
     size_t i = 0;
@@ -85,36 +22,17 @@ namespace muhamadiarov
     res[count] = '\0';
     return res;
   }
-  char *toAssociatStrings(const char *str1, char *res, size_t &size)
-  {
-    size_t i = 0;
-    while (str1[i] != '\0')
-    {
-      bool ch = checkOnRepeat(res, str1[i], size);
-      if (std::isalpha(str1[i]) && str1[i] != ' ' && !ch)
-      {
-        res[size++] = str1[i];
-      }
-      ++i;
-    }
-    return res;
-  }
   char *latTwo(const char *line1, const char *line2, char *res2)
   {
+    constexpr charset::table_t latin = charset::withLatin(charset::table_t{});
+    charset::table_t both = charset::unite(charset::fromString(line1), charset::fromString(line2));
+    charset::table_t seen = charset::intersect(both, latin);
     size_t size = 0;
-    res2 = toAssociatStrings(line1, res2, size);
-    res2 = toAssociatStrings(line2, res2, size);
-    char tch = ' ';
-    for (size_t i = 0; i < size; ++i)
+    for (size_t c = 0; c < charset::charCount; ++c)
     {
-      for (size_t j = 0; j < size - i - 1; ++j)
+      if (seen.bits[c])
       {
-        if (res2[j] > res2[j + 1])
-        {
-          tch = res2[j];
-          res2[j] = res2[j + 1];
-          res2[j + 1] = tch;
-        }
+        res2[size++] = static_cast< char >(c);
       }
     }
     res2[size] = '\0';
@@ -125,20 +43,17 @@ namespace muhamadiarov
 int main()
 {
   namespace muh = muhamadiarov;
-  char *str = nullptr;
   size_t size = 0;
-  try
-  {
-    str = muh::getline(std::cin, size);
-  }
-  catch (const std::bad_alloc&)
+  char *str = lineread::getline(std::cin, size);
+  if (str == nullptr)
   {
     std::cerr << "Error creating dinamic memmory\n";
     return 1;
   }
-  catch (const std::logic_error &e)
+  if (std::cin.eof())
   {
-    std::cerr << e.what() << '\n';
+    std::free(str);
+    std::cerr << "Error input\n";
     return 1;
   }
   char *res1 = nullptr;
@@ -151,7 +66,7 @@ int main()
   catch (const std::bad_alloc&)
   {
     std::cerr << "Error creating dinamic memmory\n";
-    delete[] str;
+    std::free(str);
     return 1;
   }
   const char *line2 = "def ghk";
@@ -168,14 +83,14 @@ int main()
   {
     std::cerr << "Error creating dinamic memmory\n";
     delete[] res1;
-    delete[] str;
+    std::free(str);
     return 1;
   }
   std::cout << res1;
   std::cout << '\n';
   std::cout << res2;
   std::cout << '\n';
-  delete[] str;
+  std::free(str);
   delete[] res1;
   delete[] res2;
   return 0;
@@ -1,8 +1,11 @@
+#include <bitset>
 #include <cstddef>
-#include <cstdlib>
+#include <cstring>
 #include <ios>
 #include <iostream>
 #include <istream>
+#include <ascii.hpp>
+#include <lineread.hpp>
 
 namespace novikov {
   const char literal[] = "abs\0";
@@ -10,132 +13,80 @@ namespace novikov {
   const size_t alphabet_size = 26;
   const size_t ascii_size = 256;
 
-  size_t countLatin(const char * str)
+  void fillQuota(const char * literal, unsigned int * quota)
   {
-    size_t count = 0;
-    char unique[alphabet_size] = {0};
-
-    for (size_t i = 0; str[i] != '\0'; ++i) {
-      if (std::isalpha(str[i])) {
-        size_t j = 0;
-        while (j < count && unique[j] != std::tolower(str[i])) {
-          ++j;
-        }
-        if (unique[j] == 0) {
-          unique[j] = std::tolower(str[i]);
-          ++count;
-        }
-      }
-    }
-
-    return count;
-  }
-
-  size_t countSame(const char * str, const char * literal)
-  {
-    size_t count1[ascii_size] = {0};
-    size_t count2[ascii_size] = {0};
-    size_t sameCount = 0;
-
-    for (size_t i = 0; str[i] != '\0'; ++i) {
-      ++count1[static_cast< unsigned char >(str[i])];
+    for (size_t i = 0; i < ascii_size; ++i) {
+      quota[i] = 0;
     }
-
     for (size_t i = 0; literal[i] != '\0'; ++i) {
-      ++count2[static_cast< unsigned char >(literal[i])];
-    }
-
-    for (size_t i = 0; i < ascii_size; ++i) {
-      if (count1[i] > 0 && count2[i] > 0) {
-        sameCount += count1[i] < count2[i] ? count1[i] : count2[i];
-      }
+      ++quota[static_cast< unsigned char >(literal[i])];
     }
-
-    return sameCount;
   }
 
-  void extend(char ** str, size_t size, size_t & capacity)
+  size_t takeSame(const char * str, size_t len, unsigned int * quota)
   {
-    char * temp = reinterpret_cast< char * >(malloc(capacity * 2));
-    if (temp == nullptr) {
-      return;
-    }
-    for (size_t i = 0; i < size; ++i) {
-      temp[i] = (*str)[i];
+    size_t sameCount = 0;
+    for (size_t i = 0; i < len; ++i) {
+      unsigned int & left = quota[static_cast< unsigned char >(str[i])];
+      unsigned int take = left != 0;
+      sameCount += take;
+      left -= take;
     }
-    *str = temp;
-    capacity *= 2;
+    return sameCount;
   }
 
-  char * getline(std::istream & in, size_t & size)
+  bool countLine(std::istream & in, const unsigned int * quota, size_t & size, size_t & latin, size_t & same)
   {
-    bool is_skipws = in.flags() & std::ios_base::skipws;
-    if (is_skipws) {
-      in >> std::noskipws;
-    }
-
-    size_t capacity = 2;
-    char * str = reinterpret_cast< char * >(malloc(capacity * sizeof(char)));
-
-    if (str == nullptr) {
-      if (is_skipws) {
-        in >> std::noskipws;
-      }
-      return nullptr;
-    }
-    while (in) {
-      if (size + 1 == capacity) {
-        char * old_str = str;
-        extend(&str, size, capacity);
-        if (size + 1 == capacity) {
-          free(str);
-          str = nullptr;
-          break;
-        }
-        free(old_str);
-      }
-      if (str == nullptr) {
-        if (is_skipws) {
-          in >> std::noskipws;
-        }
-        return nullptr;
+    const size_t block_size = 4096;
+    char block[block_size + 1];
+    unsigned int left[ascii_size];
+    std::memcpy(left, quota, sizeof(left));
+
+    unsigned long mask = 0;
+    bool terminated = false;
+    bool done = false;
+    size = 0;
+    same = 0;
+    while (!done) {
+      size_t got = 0;
+      lineread::Block state = lineread::readBlock(in, block, block_size, got);
+      if (state == lineread::Block::failed) {
+        return false;
       }
-      in >> str[size];
-      if (!in || str[size] == '\n') {
-        break;
+      done = (state == lineread::Block::last);
+
+      if (!terminated) {
+        const char * nul = reinterpret_cast< const char * >(std::memchr(block, '\0', got));
+        size_t visible = nul != nullptr ? nul - block : got;
+        terminated = nul != nullptr;
+        mask |= ascii::latinMask(block, visible);
+        same += takeSame(block, visible, left);
       }
-      ++size;
-    }
-
-    if (str) {
-      str[size] = '\0';
+      size += got;
     }
 
-    if (is_skipws) {
-      in >> std::skipws;
-    }
-    return str;
+    latin = std::bitset< alphabet_size >(mask).count();
+    return true;
   }
 }
 
 int main()
 {
-  size_t size = 0;
-  char * str = novikov::getline(std::cin, size);
+  std::ios_base::sync_with_stdio(false);
+  unsigned int quota[novikov::ascii_size];
+  novikov::fillQuota(novikov::literal, quota);
 
-  if (str == nullptr) {
+  size_t size = 0;
+  size_t result1 = 0;
+  size_t result2 = 0;
+  if (!novikov::countLine(std::cin, quota, size, result1, result2)) {
     std::cerr << "Reading failed\n";
     return 1;
   } else if (size == 0) {
-    free(str);
     std::cerr << "String is empty\n";
     return 1;
   }
 
-  size_t result1 = novikov::countLatin(str);
-  size_t result2 = novikov::countSame(str, novikov::literal);
-
   std::cout << result1 << "\n";
   std::cout << result2 << "\n";
-  free(str);
 }
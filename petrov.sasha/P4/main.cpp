@@ -2,77 +2,50 @@
 #include <iomanip>
 #include <cctype>
 #include <cstring>
+#include <charset.hpp>
+#include <lineread.hpp>
+#include <smallstr.hpp>
 namespace petrov {
-  char* getLine(std::istream& input, size_t& lenght)
+  using line_t = smallstr::String<>;
+
+  bool getLine(std::istream& input, line_t& line)
   {
-    bool skipWs = input.flags() & std::ios::skipws;
-    if (skipWs) {
-      input >> std::noskipws;
-    }
-    char* resStr = nullptr;
-    char tmp = ' ';
-    lenght = 0;
-    while (input >> tmp && tmp != '\n') {
-      char* tmpStr = reinterpret_cast< char* >(malloc(lenght + 2));
-      if (tmpStr == nullptr) {
-        free(resStr);
-        if (skipWs) {
-          input >> std::skipws;
-        }
-        return nullptr;
+    line.clear();
+    while (true) {
+      size_t got = 0;
+      lineread::Block block = lineread::readBlock(input, line.data() + line.size(), line.capacity() - line.size(), got);
+      if (block == lineread::Block::failed) {
+        line.clear();
+        return false;
       }
-      for (size_t i = 0; i < lenght; ++i) {
-        tmpStr[i] = resStr[i];
+      line.resize(line.size() + got);
+      if (block == lineread::Block::last) {
+        return true;
       }
-      free(resStr);
-      resStr = tmpStr;
-      resStr[lenght] = tmp;
-      lenght++;
-      resStr[lenght] = '\0';
-    }
-    if (!input) {
-      free(resStr);
-      if (skipWs) {
-        input >> std::skipws;
+      if (!line.reserve(line.capacity() + 1)) {
+        line.clear();
+        return false;
       }
-      return nullptr;
-    }
-    if (skipWs) {
-      input >> std::skipws;
     }
-    return resStr;
   }
-  void duplicateForUncSym(const char* str1, const char* str2, char* result, size_t& place)
+  void takeMarked(const char* str, charset::table_t& marked, char* result, size_t& place)
   {
-    for (size_t i = 0; str1[i] != '\0'; ++i) {
-      bool flag1 = false;
-      for (size_t j = 0; str2[j] != '\0'; ++j) {
-        if (str1[i] == str2[j]) {
-          flag1 = true;
-          break;
-        }
-      }
-      if (!flag1) {
-        bool flag2 = false;
-        for (size_t k = 0; k < place; ++k) {
-          if (result[k] == str1[i]) {
-            flag2 = true;
-            break;
-          }
-        }
-        if (!flag2) {
-          result[place++] = str1[i];
-        }
-      }
+    for (size_t i = 0; str[i] != '\0'; ++i) {
+      unsigned char& mark = marked.bits[static_cast< unsigned char >(str[i])];
+      result[place] = str[i];
+      place += mark;
+      mark = 0;
     }
   }
 
-  void doUncSym(const char* str1, const char* str2, char* result)
+  size_t doUncSym(const char* str1, const char* str2, char* result)
   {
+    charset::table_t unique = charset::symmetricDifference(charset::fromString(str1), charset::fromString(str2));
     size_t place = 0;
-    duplicateForUncSym(str1, str2, result, place);
-    duplicateForUncSym(str2, str1, result, place);
+    takeMarked(str1, unique, result, place);
+    takeMarked(str2, unique, result, place);
     result[place] = '\0';
+    return place;
   }
 
   size_t doSeqSym(const char* str)
@@ -88,28 +61,26 @@ namespace petrov {
 
 int main()
 {
-  char* str = nullptr;
-  size_t len = 0;
-  str = petrov::getLine(std::cin, len);
+  petrov::line_t str;
+  if (!petrov::getLine(std::cin, str)) {
+    std::cerr << (std::cin.bad() ? "Input failed\n" : "Alloc failed\n");
+    return 1;
+  }
+  size_t len = str.size();
   if (len == 0) {
     std::cerr << "Empty input\n";
-    free(str);
     return 1;
   }
   const char* sec_str = "abc ef";
   const size_t sec_len = std::strlen(sec_str);
-  char* ansUncSym = reinterpret_cast< char* >(malloc(len + sec_len + 1));
-  if (ansUncSym == nullptr) {
+  petrov::line_t ansUncSym;
+  if (!ansUncSym.reserve(len + sec_len)) {
     std::cerr << "Alloc failed\n";
-    free(str);
     return 1;
   }
-  ansUncSym[len + sec_len] = '\0';
-  petrov::doUncSym(str, sec_str, ansUncSym);
-  size_t ansSeqSym = petrov::doSeqSym(str);
-  std::cout << ansUncSym << '\n';
+  ansUncSym.resize(petrov::doUncSym(str.c_str(), sec_str, ansUncSym.data()));
+  size_t ansSeqSym = petrov::doSeqSym(str.c_str());
+  std::cout << ansUncSym.c_str() << '\n';
   std::cout << ansSeqSym << '\n';
-  free(str);
-  free(ansUncSym);
   return 0;
 }
@@ -0,0 +1,21 @@
+#include "outputSink.hpp"
+#include <ostream>
+
+namespace pozdnyakov
+{
+  OutputSink::OutputSink(std::ostream &out):
+    out_(out),
+    size_(0)
+  {}
+
+  OutputSink::~OutputSink()
+  {
+    flush();
+  }
+
+  void OutputSink::flush()
+  {
+    out_.write(buffer_, size_);
+    size_ = 0;
+  }
+}
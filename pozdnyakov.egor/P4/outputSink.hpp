@@ -0,0 +1,34 @@
+#ifndef OUTPUTSINK_HPP
+#define OUTPUTSINK_HPP
+
+#include <iosfwd>
+#include <cstddef>
+
+namespace pozdnyakov
+{
+  class OutputSink
+  {
+  public:
+    explicit OutputSink(std::ostream &out);
+    OutputSink(const OutputSink &) = delete;
+    OutputSink &operator=(const OutputSink &) = delete;
+    ~OutputSink();
+
+    void put(char ch)
+    {
+      if (size_ == CAPACITY) {
+        flush();
+      }
+      buffer_[size_++] = ch;
+    }
+    void flush();
+
+  private:
+    static constexpr size_t CAPACITY = 4096;
+    std::ostream &out_;
+    char buffer_[CAPACITY];
+    size_t size_;
+  };
+}
+
+#endif
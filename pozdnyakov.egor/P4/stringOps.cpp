@@ -1,175 +1,114 @@
 #include "stringOps.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <new>
+#include <ascii.hpp>
+#include <lineread.hpp>
+#include "outputSink.hpp"
 
 namespace pozdnyakov
 {
-  bool isAlpha(char ch)
-  {
-    return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z');
-  }
-
-  char toLower(char ch)
-  {
-    if (ch >= 'A' && ch <= 'Z') {
-      return ch + ('a' - 'A');
-    }
-    return ch;
-  }
-
-  size_t getLength(const char *str)
-  {
-    size_t len = 0;
-    while (str[len] != '\0') {
-      ++len;
-    }
-    return len;
-  }
-
   bool isSeparator(char ch)
   {
     return ch == ' ' || ch == '\t' || ch == '\v' || ch == '\f' || ch == '\r';
   }
 
-  void fillCharMap(const char *str, bool *map)
+  unsigned long getLetterMask(const char *str)
   {
-    for (size_t i = 0; str[i] != '\0'; ++i) {
-      if (isAlpha(str[i])) {
-        char lowerCh = toLower(str[i]);
-        map[lowerCh - 'a'] = true;
-      }
-    }
+    return ascii::latinMask(str, std::strlen(str));
   }
 
   void cleanupWords(char **words, size_t count)
   {
-    for (size_t i = 0; i < count; ++i) {
-      delete[] words[i];
+    if (words != nullptr && count != 0) {
+      std::free(words[0]);
     }
     delete[] words;
   }
 
-  char *readWord(std::istream &in, bool (*check)(char))
+  template< class T >
+  T *growArray(T *data, size_t size, size_t &capacity)
   {
-    size_t capacity = 16;
-    size_t size = 0;
-    char *str = nullptr;
-    char ch;
-
-    while (in.get(ch)) {
-      if (ch == '\n') {
-        return nullptr;
-      }
-      if (!check(ch)) {
-        in.unget();
-        break;
-      }
-    }
-
-    if (!in) {
-      return nullptr;
+    size_t newCapacity = capacity * 2;
+    T *newData = new T[newCapacity];
+    for (size_t i = 0; i < size; ++i) {
+      newData[i] = data[i];
     }
-
-    str = new char[capacity];
-
-    while (in.get(ch)) {
-      if (ch == '\n') {
-        in.unget();
-        break;
-      }
-      if (check(ch)) {
-        break;
-      }
-
-      if (size + 1 >= capacity) {
-        size_t newCapacity = capacity * 2;
-        char *newStr = nullptr;
-        try {
-          newStr = new char[newCapacity];
-        } catch (const std::bad_alloc &) {
-          delete[] str;
-          throw;
-        }
-        for (size_t i = 0; i < size; ++i) {
-          newStr[i] = str[i];
-        }
-        delete[] str;
-        str = newStr;
-        capacity = newCapacity;
-      }
-
-      str[size] = ch;
-      ++size;
-    }
-
-    if (size == 0) {
-      delete[] str;
-      return nullptr;
-    }
-
-    str[size] = '\0';
-    return str;
+    delete[] data;
+    capacity = newCapacity;
+    return newData;
   }
 
   char **inputString(std::istream &in, size_t &count)
   {
+    size_t len = 0;
+    char *line = lineread::getline(in, len);
+    if (line == nullptr) {
+      throw std::bad_alloc();
+    }
+    size_t size = 0;
+    size_t offsetsCapacity = 8;
+    size_t *offsets = nullptr;
     char **words = nullptr;
-    char *currentWord = nullptr;
     count = 0;
 
-    while ((currentWord = readWord(in, isSeparator)) != nullptr) {
-      char **newWords = nullptr;
-      try {
-        newWords = new char *[count + 1];
-      } catch (const std::bad_alloc &) {
-        delete[] currentWord;
-        cleanupWords(words, count);
-        throw;
+    try {
+      offsets = new size_t[offsetsCapacity];
+      bool inWord = false;
+      for (size_t i = 0; i < len; ++i) {
+        char ch = line[i];
+        if (isSeparator(ch)) {
+          if (inWord) {
+            line[size++] = '\0';
+            inWord = false;
+          }
+          continue;
+        }
+        if (!inWord) {
+          if (count == offsetsCapacity) {
+            offsets = growArray(offsets, count, offsetsCapacity);
+          }
+          offsets[count++] = size;
+          inWord = true;
+        }
+        line[size++] = ch;
       }
-
-      for (size_t i = 0; i < count; ++i) {
-        newWords[i] = words[i];
+      line[size] = '\0';
+      if (count != 0) {
+        words = new char *[count];
       }
+    } catch (const std::bad_alloc &) {
+      std::free(line);
+      delete[] offsets;
+      count = 0;
+      throw;
+    }
 
-      newWords[count] = currentWord;
-      ++count;
-
-      delete[] words;
-      words = newWords;
+    for (size_t i = 0; i < count; ++i) {
+      words[i] = line + offsets[i];
+    }
+    delete[] offsets;
+    if (count == 0) {
+      std::free(line);
     }
     return words;
   }
 
-  void replaceChars(const char *input, char *output, char oldChar, char newChar)
+  void replaceChars(const char *input, OutputSink &out, char oldChar, char newChar)
   {
-    size_t i = 0;
-    while (input[i] != '\0') {
-      if (input[i] == oldChar) {
-        output[i] = newChar;
-      } else {
-        output[i] = input[i];
-      }
-      ++i;
+    for (size_t i = 0; input[i] != '\0'; ++i) {
+      out.put(input[i] == oldChar ? newChar : input[i]);
     }
-    output[i] = '\0';
   }
 
-  void mergeLatinLetters(const char *s1, const char *s2, char *dest)
+  void mergeLatinLetters(const char *s1, unsigned long mask2, OutputSink &out)
   {
-    bool present[ALPHABET_SIZE];
-    for (size_t k = 0; k < ALPHABET_SIZE; ++k) {
-      present[k] = false;
-    }
-
-    fillCharMap(s1, present);
-    fillCharMap(s2, present);
+    unsigned long present = getLetterMask(s1) | mask2;
 
-    size_t idx = 0;
     for (size_t i = 0; i < ALPHABET_SIZE; ++i) {
-      if (present[i]) {
-        dest[idx] = static_cast< char >('a' + i);
-        ++idx;
+      if (present & (1ul << i)) {
+        out.put(static_cast< char >('a' + i));
       }
     }
-    dest[idx] = '\0';
   }
 }
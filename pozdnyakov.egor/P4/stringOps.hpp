@@ -6,18 +6,16 @@
 
 namespace pozdnyakov
 {
+  class OutputSink;
+
   constexpr size_t ALPHABET_SIZE = 26;
 
-  bool isAlpha(char ch);
-  char toLower(char ch);
-  size_t getLength(const char *str);
   bool isSeparator(char ch);
-  void fillCharMap(const char *str, bool *map);
+  unsigned long getLetterMask(const char *str);
   void cleanupWords(char **words, size_t count);
-  char *readWord(std::istream &in, bool (*check)(char));
   char **inputString(std::istream &in, size_t &count);
-  void replaceChars(const char *input, char *output, char oldChar, char newChar);
-  void mergeLatinLetters(const char *s1, const char *s2, char *dest);
+  void replaceChars(const char *input, OutputSink &out, char oldChar, char newChar);
+  void mergeLatinLetters(const char *s1, unsigned long mask2, OutputSink &out);
 }
 
 #endif
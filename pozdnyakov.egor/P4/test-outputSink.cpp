@@ -0,0 +1,88 @@
+#define BOOST_TEST_MODULE P4
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include "outputSink.hpp"
+#include "stringOps.hpp"
+
+namespace
+{
+  size_t allocations = 0;
+
+  class ArrayBuf: public std::streambuf
+  {
+  public:
+    ArrayBuf(char *data, size_t size)
+    {
+      setp(data, data + size);
+    }
+
+    size_t size() const
+    {
+      return pptr() - pbase();
+    }
+  };
+}
+
+void *operator new(size_t size)
+{
+  ++allocations;
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+BOOST_AUTO_TEST_CASE(output_loop_does_not_allocate)
+{
+  const size_t count = 3000;
+  std::string line;
+  for (size_t i = 0; i < count; ++i) {
+    line += "cab ";
+  }
+  std::istringstream in(line);
+  size_t wordsCount = 0;
+  char **words = pozdnyakov::inputString(in, wordsCount);
+  BOOST_TEST(wordsCount == count);
+
+  static char data[65536];
+  ArrayBuf buf(data, sizeof(data));
+  std::ostream out(&buf);
+
+  size_t before = allocations;
+  {
+    pozdnyakov::OutputSink sink(out);
+    for (size_t i = 0; i < wordsCount; ++i) {
+      pozdnyakov::replaceChars(words[i], sink, 'c', 'b');
+      sink.put('\n');
+      pozdnyakov::mergeLatinLetters(words[i], 0, sink);
+      sink.put('\n');
+    }
+  }
+  BOOST_TEST(allocations == before);
+  pozdnyakov::cleanupWords(words, wordsCount);
+
+  const char expected[] = "bab\nabc\n";
+  const size_t expectedSize = sizeof(expected) - 1;
+  BOOST_TEST(buf.size() == count * expectedSize);
+  bool same = true;
+  for (size_t i = 0; i < count; ++i) {
+    same = same && std::memcmp(data + i * expectedSize, expected, expectedSize) == 0;
+  }
+  BOOST_TEST(same);
+}
@@ -1,77 +1,106 @@
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <lineread.hpp>
 
 namespace saldaev
 {
-  const size_t block_size = 10;
+  const size_t chunk_size = 4096;
 
-  char *getLine(std::istream &in, size_t &len, const size_t block_size = block_size)
+  size_t collapseRuns(const char *data, size_t len, char *new_arr, const bool *in_class, char &prev_char)
   {
-    char *data = reinterpret_cast< char * >(malloc((block_size + 1) * sizeof(char)));
+    size_t crnt_digit = 0;
+    bool prev_in = in_class[static_cast< unsigned char >(prev_char)];
+    for (size_t i = 0; i < len; ++i) {
+      char crnt_char = data[i];
+      bool crnt_in = in_class[static_cast< unsigned char >(crnt_char)];
+      new_arr[crnt_digit] = crnt_char;
+      crnt_digit += !(crnt_in && prev_in);
+      prev_in = crnt_in;
+    }
+    if (len != 0) {
+      prev_char = data[len - 1];
+    }
+    return crnt_digit;
+  }
+
+  size_t spcRmv(const char *data, size_t len, char *new_arr, char &prev_char)
+  {
+    bool is_space[256] = {};
+    is_space[static_cast< unsigned char >(' ')] = true;
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t high_bits = 0x8080808080808080ull;
+    const uint64_t spaces = ones * static_cast< unsigned char >(' ');
+
+    size_t crnt_digit = 0;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+      uint64_t word = 0;
+      std::memcpy(&word, data + i, 8);
+      uint64_t diff = word ^ spaces;
+      if (((diff - ones) & ~diff & high_bits) == 0) {
+        std::memcpy(new_arr + crnt_digit, data + i, 8);
+        crnt_digit += 8;
+        prev_char = data[i + 7];
+      } else {
+        crnt_digit += collapseRuns(data + i, 8, new_arr + crnt_digit, is_space, prev_char);
+      }
+    }
+    crnt_digit += collapseRuns(data + i, len - i, new_arr + crnt_digit, is_space, prev_char);
+    return crnt_digit;
+  }
+
+  char *spcRmvLine(std::istream &in, std::ostream &out, size_t &len)
+  {
+    size_t capacity = chunk_size;
+    char *data = reinterpret_cast< char * >(malloc((capacity + 1) * sizeof(char)));
     if (data == nullptr) {
       return nullptr;
     }
-    bool skipws_on = in.flags() & std::ios_base::skipws;
-    if (skipws_on) {
-      in >> std::noskipws;
-    }
 
-    size_t capacity = block_size;
+    char filtered[chunk_size];
+    char prev_char = ' ';
+    bool terminated = false;
     len = 0;
-    char crnt_char = ' ';
-    while (in >> crnt_char && crnt_char != '\r' && crnt_char != '\n') {
-      len++;
-      if (len > capacity) {
-        char *tmp = reinterpret_cast< char * >(malloc((capacity + block_size + 1) * sizeof(char)));
+    bool done = false;
+    while (!done) {
+      if (capacity - len < chunk_size) {
+        char *tmp = reinterpret_cast< char * >(realloc(data, (capacity * 2 + 1) * sizeof(char)));
         if (tmp == nullptr) {
           free(data);
-          if (skipws_on) {
-            in >> std::skipws;
-          }
           return nullptr;
         }
-        capacity += block_size;
-        for (size_t i = 0; i < len - 1; ++i) {
-          tmp[i] = data[i];
-        }
-        free(data);
+        capacity *= 2;
         data = tmp;
       }
-      data[len - 1] = crnt_char;
-    }
-    if (skipws_on) {
-      in >> std::skipws;
-    }
-    if (crnt_char == '\r' || crnt_char == '\n' || in.eof()) {
-      data[len] = '\0';
-      return data;
-    }
-    free(data);
-    return nullptr;
-  }
 
-  char *spcRmv(const char *data, char *new_arr)
-  {
-    if (new_arr == nullptr) {
-      return nullptr;
-    }
-    size_t crnt_digit = 0;
-    size_t i = 0;
-    char crnt_char = data[i];
-    char prev_char = ' ';
-    while (crnt_char != '\0') {
-      if (crnt_char != ' ' || prev_char != ' ') {
-        new_arr[crnt_digit] = crnt_char;
-        crnt_digit++;
+      char *chunk = data + len;
+      size_t got = 0;
+      lineread::Block block = lineread::readBlock(in, chunk, chunk_size, got);
+      if (block == lineread::Block::failed) {
+        free(data);
+        return nullptr;
       }
-      prev_char = crnt_char;
-      i++;
-      crnt_char = data[i];
+      done = (block == lineread::Block::last);
+
+      const char *cr = reinterpret_cast< const char * >(std::memchr(chunk, '\r', got));
+      if (cr != nullptr) {
+        got = cr - chunk;
+        done = true;
+      }
+      if (!terminated) {
+        const char *nul = reinterpret_cast< const char * >(std::memchr(chunk, '\0', got));
+        size_t visible = (nul != nullptr) ? nul - chunk : got;
+        terminated = (nul != nullptr);
+        out.write(filtered, spcRmv(chunk, visible, filtered, prev_char));
+      }
+      len += got;
     }
-    new_arr[crnt_digit] = '\0';
-    return new_arr;
+    data[len] = '\0';
+    return data;
   }
 
   char *latRmv(const char *data, char *new_arr)
@@ -97,8 +126,9 @@ namespace saldaev
 
 int main()
 {
+  std::ios_base::sync_with_stdio(false);
   size_t len = 0;
-  char *line = saldaev::getLine(std::cin, len);
+  char *line = saldaev::spcRmvLine(std::cin, std::cout, len);
   if (line == nullptr) {
     std::cerr << "Could not read the string\n";
     return 1;
@@ -108,29 +138,9 @@ int main()
     free(line);
     return 1;
   }
+  std::cout << "\n";
 
-  char *new_line = reinterpret_cast< char * >(malloc((len + 1) * sizeof(char)));
-  if (new_line == nullptr) {
-    std::cerr << "Failed to allocate memory\n";
-    free(line);
-    return 1;
-  }
-  new_line[len] = '\0';
-
-  new_line = saldaev::spcRmv(line, new_line);
-  std::cout << new_line << "\n";
-  free(new_line);
-
-  new_line = reinterpret_cast< char * >(malloc((len + 1) * sizeof(char)));
-  if (new_line == nullptr) {
-    std::cerr << "Failed to allocate memory\n";
-    free(line);
-    return 1;
-  }
-  new_line[len] = '\0';
-
-  new_line = saldaev::latRmv(line, new_line);
-  std::cout << new_line << "\n";
+  saldaev::latRmv(line, line);
+  std::cout << line << "\n";
   free(line);
-  free(new_line);
 }
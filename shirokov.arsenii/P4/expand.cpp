@@ -1,7 +1,6 @@
 #include "expand.hpp"
 #include <cmath>
 #include <cstdlib>
-#include <cstring>
 
 namespace
 {
@@ -19,54 +18,17 @@ namespace
   }
 }
 
-void shirokov::expand(char **str, size_t size, size_t &capacity)
+void shirokov::expand(size_t **offsets, size_t &capacity)
 {
   double coefficient = getCoefficient(capacity);
   size_t newCapacity = static_cast< size_t >(capacity * coefficient);
-  char *tempString = reinterpret_cast< char * >(malloc(newCapacity * sizeof(char)));
-  if (tempString == nullptr)
-  {
-    free(*str);
-    *str = nullptr;
-    return;
-  }
-  for (size_t i = 0; i < size; ++i)
-  {
-    tempString[i] = (*str)[i];
-  }
-  free(*str);
-  *str = tempString;
-  capacity = newCapacity;
-}
-
-void shirokov::expand(char ***str, size_t size, size_t &capacity)
-{
-  double coefficient = getCoefficient(capacity);
-  size_t newCapacity = static_cast< size_t >(capacity * coefficient);
-  char **tempMassive = reinterpret_cast< char ** >(malloc(newCapacity * sizeof(char *)));
+  size_t *tempMassive = reinterpret_cast< size_t * >(realloc(*offsets, newCapacity * sizeof(size_t)));
   if (tempMassive == nullptr)
   {
-    for (size_t i = 0; i < size; ++i)
-    {
-      free((*str)[i]);
-    }
-    free(*str);
-    *str = nullptr;
+    free(*offsets);
+    *offsets = nullptr;
     return;
   }
-  for (size_t i = 0; i < size; ++i)
-  {
-    size_t len = std::strlen((*str)[i]);
-    char *tempString = static_cast< char * >(malloc(len + 1));
-    for (size_t j = 0; j < len; ++j)
-    {
-      tempString[j] = (*str)[i][j];
-    }
-    tempString[len] = '\0';
-    free((*str)[i]);
-    tempMassive[i] = tempString;
-  }
-  free(*str);
-  *str = tempMassive;
+  *offsets = tempMassive;
   capacity = newCapacity;
 }
@@ -4,8 +4,7 @@
 
 namespace shirokov
 {
-  void expand(char **str, size_t size, size_t &capacity);
-  void expand(char ***str, size_t size, size_t &capacity);
+  void expand(size_t **offsets, size_t &capacity);
 }
 
 #endif
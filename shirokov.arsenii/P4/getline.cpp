@@ -1,94 +1,26 @@
 #include "getline.hpp"
-#include "expand.hpp"
+#include <cstring>
 
-char **shirokov::getline(std::istream &in, size_t &size, bool (*isDelimiter)(char symbol))
+char **shirokov::packWords(char *arena, const size_t *offsets, size_t size, size_t arenaSize)
 {
-  bool is_skipws = in.flags() & std::ios_base::skipws;
-  if (is_skipws)
+  if (size == 0)
   {
-    in >> std::noskipws;
-  }
-  char **massive = reinterpret_cast< char ** >(malloc(sizeof(char *)));
-  size_t capacity = 1;
-  size = 0;
-  char *str = reinterpret_cast< char * >(malloc(sizeof(char)));
-  size_t cap = 1;
-  size_t s = 0;
-  if (massive == nullptr || str == nullptr)
-  {
-    for (size_t i = 0; i < size; ++i)
-    {
-      free(massive[i]);
-    }
-    free(massive);
-    free(str);
-    if (is_skipws)
-    {
-      in >> std::skipws;
-    }
+    free(arena);
     return nullptr;
   }
-  while (in)
+  size_t tableSize = size * sizeof(char *);
+  char *block = reinterpret_cast< char * >(realloc(arena, tableSize + arenaSize));
+  if (block == nullptr)
   {
-    if (size == capacity)
-    {
-      expand(&massive, size, capacity);
-    }
-    if (s == cap)
-    {
-      expand(&str, s, cap);
-    }
-    if (massive == nullptr || str == nullptr)
-    {
-      for (size_t i = 0; i < size; ++i)
-      {
-        free(massive[i]);
-      }
-      free(massive);
-      free(str);
-      if (is_skipws)
-      {
-        in >> std::skipws;
-      }
-      return nullptr;
-    }
-    in >> str[s];
-    if (!in || str[s] == '\0')
-    {
-      if (s > 0)
-      {
-        massive[size++] = str;
-      }
-      else
-      {
-        free(str);
-      }
-      break;
-    }
-    bool flag = isDelimiter(str[s]);
-    if (flag)
-    {
-      if (s > 0)
-      {
-        str[s] = '\0';
-        massive[size++] = str;
-      }
-      else
-      {
-        free(str);
-      }
-      str = reinterpret_cast< char * >(malloc(sizeof(char)));
-      cap = 1;
-      s = 0;
-    }
-    if (!flag)
-    {
-      s++;
-    }
+    free(arena);
+    return nullptr;
   }
-  if (is_skipws)
+  char *words = block + tableSize;
+  std::memmove(words, block, arenaSize);
+  char **massive = reinterpret_cast< char ** >(block);
+  for (size_t i = 0; i < size; ++i)
   {
-    in >> std::skipws;
+    massive[i] = words + offsets[i];
   }
   return massive;
 }
@@ -1,10 +1,64 @@
 #ifndef GETLINE_HPP
 #define GETLINE_HPP
+#include <cstdlib>
 #include <istream>
+#include <lineread.hpp>
+#include "expand.hpp"
 
 namespace shirokov
 {
-  char **getline(std::istream &in, size_t &size, bool (*isDelimiter)(char symbol));
+  char **packWords(char *arena, const size_t *offsets, size_t size, size_t arenaSize);
+
+  template< class Predicate >
+  char **getline(std::istream &in, size_t &size, Predicate isDelimiter)
+  {
+    size_t length = 0;
+    char *arena = lineread::getline(in, length, '\0');
+    size_t capacity = 16;
+    size_t *offsets = reinterpret_cast< size_t * >(malloc(capacity * sizeof(size_t)));
+    size = 0;
+    if (offsets == nullptr || arena == nullptr)
+    {
+      free(offsets);
+      free(arena);
+      return nullptr;
+    }
+
+    size_t used = 0;
+    size_t start = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+      if (size == capacity)
+      {
+        expand(&offsets, capacity);
+        if (offsets == nullptr)
+        {
+          free(arena);
+          return nullptr;
+        }
+      }
+      char symbol = arena[i];
+      if (!isDelimiter(symbol))
+      {
+        arena[used++] = symbol;
+      }
+      else if (used > start)
+      {
+        arena[used++] = '\0';
+        offsets[size++] = start;
+        start = used;
+      }
+    }
+    if (used > start)
+    {
+      arena[used++] = '\0';
+      offsets[size++] = start;
+    }
+
+    char **massive = packWords(arena, offsets, size, used);
+    free(offsets);
+    return massive;
+  }
 }
 
 #endif
@@ -2,6 +2,8 @@
 #include <cstring>
 #include <iostream>
 #include <cstddef>
+#include <bufpool.hpp>
+#include <probe.hpp>
 #include "getline.hpp"
 
 namespace shirokov
@@ -13,12 +15,13 @@ namespace shirokov
   char *otherLatinLetters(const char *str, char *res, char *buffer);
   char *combineLines(const char *str1, size_t s1, const char *str2, size_t s2, char *res);
   bool isSpace(char symbol);
+  void reportPool();
 }
 
 int main()
 {
   size_t s = 0;
-  char **massive = shirokov::getline(std::cin, s, shirokov::isSpace);
+  char **massive = shirokov::getline(std::cin, s, [](char symbol) { return shirokov::isSpace(symbol); });
 
   if (massive == nullptr || s == 0)
   {
@@ -33,30 +36,22 @@ int main()
     for (; massive[i][length] != '\0'; ++length)
     {
     }
-    char *res1 = reinterpret_cast< char * >(malloc((shirokov::LATIN_ALPHABET_LENGTH + 1) * sizeof(char)));
-    char *res2 = reinterpret_cast< char * >(malloc((std::strlen(shirokov::LITERAL) + length + 1) * sizeof(char)));
+    char *res1 = bufpool::acquire((shirokov::LATIN_ALPHABET_LENGTH + 1) * sizeof(char));
+    char *res2 = bufpool::acquire((std::strlen(shirokov::LITERAL) + length + 1) * sizeof(char));
     if (res1 == nullptr || res2 == nullptr)
     {
-      for (size_t j = 0; j < s; ++j)
-      {
-        free(massive[j]);
-      }
       free(massive);
-      free(res1);
-      free(res2);
+      bufpool::release(res1);
+      bufpool::release(res2);
       std::cerr << "Memory allocation error\n";
       return 1;
     }
-    char *buffer = reinterpret_cast< char * >(malloc(sizeof(char) * (length + 1)));
+    char *buffer = bufpool::acquire(sizeof(char) * (length + 1));
     if (buffer == nullptr)
     {
-      for (size_t j = 0; j < s; ++j)
-      {
-        free(massive[j]);
-      }
       free(massive);
-      free(res1);
-      free(res2);
+      bufpool::release(res1);
+      bufpool::release(res2);
       std::cerr << "Memory allocation error\n";
       return 1;
     }
@@ -69,14 +64,11 @@ int main()
     std::cout << "String: " << massive[i] << '\n';
     std::cout << "\t1. " << res1 << '\n';
     std::cout << "\t2. " << res2 << '\n';
-    free(res1);
-    free(res2);
-    free(buffer);
-  }
-  for (size_t i = 0; i < s; ++i)
-  {
-    free(massive[i]);
+    bufpool::release(res1);
+    bufpool::release(res2);
+    bufpool::release(buffer);
   }
+  shirokov::reportPool();
   free(massive);
 }
 
@@ -147,6 +139,15 @@ char *shirokov::uniq(char *res, const char *str, size_t &rsize)
   return res;
 }
 
+void shirokov::reportPool()
+{
+  bufpool::stats_t stats = bufpool::stats();
+  PROBE_COUNT("bufpool acquires", stats.acquires);
+  PROBE_COUNT("bufpool hits", stats.hits);
+  PROBE_COUNT("bufpool hit rate, %", stats.acquires == 0 ? 0 : stats.hits * 100 / stats.acquires);
+  PROBE_COUNT("bufpool bytes retained", stats.bytesRetained);
+}
+
 bool shirokov::isSpace(char symbol)
 {
   if (symbol == ' ' || symbol == '\t' || symbol == '\n')
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <mtxbuf.hpp>
 namespace sogdanov
 {
   std::istream & readMatrix(std::ifstream & input, int * mtx, size_t rows, size_t cols)
@@ -30,20 +31,32 @@ namespace sogdanov
       }
       rowMin[i] = minValue;
     }
-    size_t count = 0;
-    for (size_t i = 0; i < cols; ++i) {
-      int maxVal = mtx[i];
-      for (size_t j = 1; j < rows; ++j) {
-        if (mtx[j * cols + i] > maxVal) {
-          maxVal = mtx[j * cols + i];
+    int * colMax = reinterpret_cast< int * >(malloc(cols * sizeof(int)));
+    if (colMax == nullptr) {
+      free(rowMin);
+      return -1;
+    }
+    for (size_t j = 0; j < cols; ++j) {
+      colMax[j] = mtx[j];
+    }
+    for (size_t i = 1; i < rows; ++i) {
+      const int * row = mtx + i * cols;
+      for (size_t j = 0; j < cols; ++j) {
+        if (row[j] > colMax[j]) {
+          colMax[j] = row[j];
         }
       }
-      for (size_t j = 0; j < rows; ++j) {
-        if (mtx[j * cols + i] == maxVal && mtx[j * cols + i] == rowMin[j]) {
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < rows; ++i) {
+      const int * row = mtx + i * cols;
+      for (size_t j = 0; j < cols; ++j) {
+        if (row[j] == colMax[j] && row[j] == rowMin[i]) {
           count++;
         }
       }
     }
+    free(colMax);
     free(rowMin);
     return count;
   }
@@ -74,16 +87,6 @@ namespace sogdanov
     }
     return maxSum;
   }
-  int * createMatrix(size_t rows, size_t cols)
-  {
-    return reinterpret_cast< int * >(malloc(rows * cols * sizeof(int)));
-  }
-  void rm(long num, int * mtx)
-  {
-    if (num == 2 && mtx != nullptr) {
-      free(mtx);
-    }
-  }
 }
 
 int main(int argc, char ** argv)
@@ -106,6 +109,11 @@ int main(int argc, char ** argv)
     std::cerr << "First argument is not a number\n";
     return 1;
   }
+  mtxbuf::Policy policy = mtxbuf::Policy::plain;
+  if (!mtxbuf::policyFromEnv(policy)) {
+    std::cerr << "Unknown LAB_MTX_ALLOC policy\n";
+    return 1;
+  }
   std::ifstream input(argv[2]);
   if (!input) {
     std::cerr << "Cannot open input file\n";
@@ -125,10 +133,11 @@ int main(int argc, char ** argv)
   const int SIZE = 10000;
   int mtx_on_stack[SIZE] = {};
   int * mtx = nullptr;
+  mtxbuf::Buffer heap_mtx(policy);
   if (num == 1) {
     mtx = mtx_on_stack;
   } else if (num == 2) {
-    mtx = sogdanov::createMatrix(rows, cols);
+    mtx = heap_mtx.allocate(rows * cols);
   }
   if (mtx == nullptr) {
     std::cerr << "Memory allocation failed\n";
@@ -137,23 +146,19 @@ int main(int argc, char ** argv)
   sogdanov::readMatrix(input, mtx, rows, cols);
   if (input.fail()) {
     std::cerr << "Input error\n";
-    sogdanov::rm(num, mtx);
     return 2;
   }
   int extra;
   if (input >> extra) {
     std::cerr << "Too many elements in input file\n";
-    sogdanov::rm(num, mtx);
     return 2;
   }
   int res1 = sogdanov::maxSumSdg(mtx, rows, cols);
   int res2 = sogdanov::cntSdlPnt(mtx, rows, cols);
   if (res2 < 0) {
     std::cerr << "Memory allocation failed\n";
-    sogdanov::rm(num,mtx);
     return 2;
   }
-  sogdanov::rm(num, mtx);
   std::ofstream output(argv[3]);
   if (!output) {
     std::cerr << "Cannot open output file\n";
@@ -1,72 +1,15 @@
 #include <iostream>
 #include <cctype>
+#include <cstdlib>
+#include <charset.hpp>
+#include <lineread.hpp>
 
 namespace strelnikov {
 
-  using std::free;
-  char* addSymb(const char* str, size_t& s, char ch)
-  {
-    char* tmp = reinterpret_cast< char* >(malloc(s + 2));
-    if (!tmp) {
-      return nullptr;
-    }
-
-    for (size_t i = 0; i < s; ++i) {
-      tmp[i] = str[i];
-    }
-
-    tmp[s] = ch;
-    tmp[s + 1] = '\0';
-
-    ++s;
-    return tmp;
-  }
-
-  char* getString(std::istream& in, size_t& s)
-  {
-    bool isSkipWp = in.flags() & std::ios::skipws;
-    if (isSkipWp) {
-      in >> std::noskipws;
-    }
-    char* res = nullptr;
-    s = 0;
-
-    char ch;
-    while (in >> ch && ch != '\n') {
-      char* tmp = addSymb(res, s, ch);
-      free(res);
-      if (!tmp) {
-        if (isSkipWp) {
-          in >> std::skipws;
-        }
-        return nullptr;
-      }
-      res = tmp;
-    }
-
-    if (in.fail() && !in.eof()) {
-      free(res);
-      if (isSkipWp) {
-        in >> std::skipws;
-      }
-      return nullptr;
-    }
-    if (isSkipWp) {
-      in >> std::skipws;
-    }
-    return res;
-  }
-
   int doHasSam(char* str1, char* str2)
   {
-    for (size_t i = 0; str1[i] != '\0'; ++i) {
-      for (size_t j = 0; str2[j] != '\0'; ++j) {
-        if (str1[i] == str2[j]) {
-          return 1;
-        }
-      }
-    }
-    return 0;
+    charset::table_t common = charset::intersect(charset::fromString(str1), charset::fromString(str2));
+    return charset::isEmpty(common) ? 0 : 1;
   }
 
   void doDgtSnd(char* resultBuffer, const char* str1, const char* digits)
@@ -89,8 +32,9 @@ namespace strelnikov {
 int main()
 {
   size_t s1 = 0;
-  char* str1 = strelnikov::getString(std::cin, s1);
+  char* str1 = lineread::getline(std::cin, s1);
   if (!str1 || s1 == 0) {
+    std::free(str1);
     return 1;
   }
   char strHas[] = "abc";